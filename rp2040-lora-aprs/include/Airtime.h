@@ -0,0 +1,32 @@
+#ifndef RP2040_LORA_APRS_AIRTIME_H
+#define RP2040_LORA_APRS_AIRTIME_H
+
+#include <Arduino.h>
+#include "Settings.h"
+#include "config.h"
+
+// Time on air sent over a sliding hour, in buckets of one minute stamped with their minute
+class Airtime {
+public:
+    static uint32_t timeOnAir(size_t size, const SettingsLoRa &settings);
+
+    void add(uint32_t milliseconds);
+    // Is sending milliseconds more allowed by the duty cycle, for the given percentage of it
+    bool isAllowed(uint32_t milliseconds, uint16_t dutyCyclePerMille, uint8_t budgetPercent = 100) const;
+
+    uint32_t lastHour() const;
+    uint16_t dutyCyclePerMille() const;
+
+    inline uint64_t getTotal() const {
+        return total;
+    }
+
+    uint32_t deferred = 0;
+    uint32_t dropped = 0;
+private:
+    uint32_t buckets[AIRTIME_WINDOW_MINUTES]{};
+    uint32_t minutes[AIRTIME_WINDOW_MINUTES]{};
+    uint64_t total = 0;
+};
+
+#endif //RP2040_LORA_APRS_AIRTIME_H
@@ -0,0 +1,97 @@
+#ifndef RP2040_LORA_APRS_APRSHEARDLIST_H
+#define RP2040_LORA_APRS_APRSHEARDLIST_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "Aprs.h"
+#include "Timer.h"
+#include "config.h"
+
+typedef struct {
+    char callsign[CALLSIGN_LENGTH];
+    char digipeaterCallsign[CALLSIGN_LENGTH];
+    uint32_t time;
+    uint32_t count;
+    float rssi;
+    float snr;
+    uint8_t digipeaterCount;
+} AprsHeard;
+
+typedef struct {
+    uint32_t appended;
+    uint32_t flushes;
+    uint32_t compactions;
+    uint32_t evicted;
+} AprsHeardLogStats;
+
+// Stations heard, indexed by callsign and evicted least recently heard first.
+// Only the last packets are kept, in a ring shared by all stations.
+// Persisted in their own append only log which is compacted when it grows too much.
+class AprsHeardList {
+public:
+    bool begin();
+    AprsHeard *add(const AprsPacketLite *packet, uint32_t time, float snr, float rssi);
+    AprsHeard *find(const char *callsign) const;
+    void clear();
+    // Append the changed stations once the coalescing timer has expired, or now if forced
+    bool flush(bool force = false);
+
+    // Last raw packet of the station, empty if no more kept
+    const char *getPacket(const AprsHeard *station) const;
+
+    // Most recently heard first, nullptr after the last one
+    AprsHeard *first() const;
+    AprsHeard *next(const AprsHeard *station) const;
+
+    inline AprsHeard *getLast() const {
+        return first();
+    }
+
+    inline uint16_t size() const {
+        return count;
+    }
+
+    inline uint16_t getRecordsInLog() const {
+        return recordsInLog;
+    }
+
+    AprsHeardLogStats stats{};
+private:
+    static constexpr uint16_t NONE = 0xFFFF;
+    static constexpr uint8_t NO_PACKET = 0xFF;
+
+    AprsHeard stations[APRS_HEARD_STATIONS]{};
+    uint16_t count = 0;
+
+    // Open addressing on the callsign hash, station index + 1 and 0 for empty
+    uint16_t index[APRS_HEARD_INDEX_SIZE]{};
+
+    uint16_t lruPrevious[APRS_HEARD_STATIONS]{};
+    uint16_t lruNext[APRS_HEARD_STATIONS]{};
+    uint16_t lruHead = NONE;
+    uint16_t lruTail = NONE;
+
+    char packets[APRS_HEARD_PACKETS][MAX_PACKET_LENGTH]{};
+    uint16_t packetOwner[APRS_HEARD_PACKETS]{};
+    uint8_t packetSlot[APRS_HEARD_STATIONS]{};
+    uint8_t packetNext = 0;
+
+    bool dirty[APRS_HEARD_STATIONS]{};
+    uint16_t recordsInLog = 0;
+    Timer timerFlush = Timer(INTERVAL_FLUSH_APRS_HEARD);
+
+    static uint16_t hash(const char *callsign);
+    uint16_t findIndex(const char *callsign) const;
+    AprsHeard *upsert(const char *callsign);
+    void evict();
+    void unlink(uint16_t station);
+    void pushFront(uint16_t station);
+    void setPacket(uint16_t station, const char *packet, size_t length);
+
+    bool load();
+    bool migrate();
+    bool compact();
+    bool writeRecord(File &file, uint16_t station);
+};
+
+#endif //RP2040_LORA_APRS_APRSHEARDLIST_H
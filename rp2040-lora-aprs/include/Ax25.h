@@ -0,0 +1,35 @@
+#ifndef RP2040_LORA_APRS_AX25_H
+#define RP2040_LORA_APRS_AX25_H
+
+#include <cstddef>
+#include <cstdint>
+
+#define AX25_ADDRESS_LENGTH 7 // 6 characters shifted by one bit and the SSID byte
+#define AX25_CALLSIGN_LENGTH 6
+#define AX25_DIGIPEATERS_MAX 8
+#define AX25_CONTROL_UI 0x03
+#define AX25_PID_NO_LAYER3 0xF0
+#define AX25_HEADER_MIN (2 * AX25_ADDRESS_LENGTH + 2) // Destination, source, control and PID
+// Longest text of an address is "CALLSG-15*," against its 7 bytes
+#define AX25_TEXT_MAX(frameSize) ((frameSize) + ((frameSize) / AX25_ADDRESS_LENGTH) * 4 + 1)
+
+// Frame formats on air, by lora.frameFormat
+enum LoRaFrameFormat : uint8_t {
+    LoRaFrameText, // '<', 0xFF, 0x01 then the TNC2 text
+    LoRaFrameAx25 // AX.25 UI frame without flags nor FCS, LoRa has its own CRC
+};
+
+// Conversion between the TNC2 text of an APRS frame, "SOURCE>DEST,DIGI1*,DIGI2:information", and an AX.25 UI frame.
+// The repeated flag of the last digipeater with a '*' is set on it and all the previous ones.
+class Ax25 {
+public:
+    // Size written, 0 if the text has an address not allowed by AX.25 or doesn't fit
+    static size_t encode(const char *text, size_t length, uint8_t *out, size_t outSize);
+    // Length of the text written with its end of string, 0 if it is not an AX.25 UI frame
+    static size_t decode(const uint8_t *frame, size_t size, char *out, size_t outSize);
+private:
+    static bool encodeAddress(const char *address, size_t length, uint8_t *out, bool *repeated);
+    static size_t decodeAddress(const uint8_t *address, char *out);
+};
+
+#endif //RP2040_LORA_APRS_AX25_H
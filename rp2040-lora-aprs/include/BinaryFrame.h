@@ -0,0 +1,114 @@
+#ifndef RP2040_LORA_APRS_BINARYFRAME_H
+#define RP2040_LORA_APRS_BINARYFRAME_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Without Arduino, also built by the decoder of the Linux board in scripts/mcu-binary
+
+#define BINARY_FRAME_PAYLOAD_MAX 320
+#define BINARY_FRAME_HEADER 3 // Type and length
+#define BINARY_FRAME_CRC 2
+// COBS adds a byte every 254 and the frame is between two delimiters
+#define BINARY_FRAME_ENCODED_MAX (BINARY_FRAME_HEADER + BINARY_FRAME_PAYLOAD_MAX + BINARY_FRAME_CRC + (BINARY_FRAME_HEADER + BINARY_FRAME_PAYLOAD_MAX + BINARY_FRAME_CRC) / 254 + 3)
+#define BINARY_CALLSIGN_LENGTH 10
+
+enum BinaryMessageType : uint8_t {
+    BinaryStatus = 1, // BinaryStatusPayload, pushed at interval or on the binary command
+    BinaryStation = 2, // BinaryStationPayload, stations heard on the binary command
+    BinaryHeard = 3, // BinaryStationPayload, pushed as soon as a frame is received
+    BinaryError = 4, // One byte of BinaryErrorFlag, pushed when it changes
+    BinaryWatchdogFired = 5 // Name of the watchdog, pushed when it toggles its pin or reboots
+};
+
+enum BinaryErrorFlag : uint8_t {
+    BinaryErrorLoRa = 1 << 0,
+    BinaryErrorEnergy = 1 << 1,
+    BinaryErrorWeather = 1 << 2
+};
+
+enum BinaryStatusFlag : uint8_t {
+    BinaryBoxOpened = 1 << 0,
+    BinaryDigipeatOnlyDirect = 1 << 1,
+    BinaryLightSleep = 1 << 2
+};
+
+// Little endian, as both the RP2040 and the Linux board
+typedef struct __attribute__((packed)) {
+    uint32_t uptime; // s
+    uint32_t time; // Unix time
+    uint8_t errors; // BinaryErrorFlag
+    uint8_t flags; // BinaryStatusFlag
+    uint8_t loadSheddingTier;
+    uint8_t txQueueDepth;
+    uint32_t airtimeLastHour; // ms
+    uint32_t airtimeTotal; // s
+    uint16_t dutyCycle; // Per mille
+    uint32_t framesSent;
+    uint32_t framesDropped;
+    uint32_t dupeHits;
+    int16_t voltageBattery; // mV
+    int16_t currentBattery; // mA
+    int16_t voltageSolar; // mV
+    int16_t currentSolar; // mA
+    int16_t temperatureRtc; // 1/100 °C
+    int16_t temperatureBattery; // 1/100 °C
+    int16_t temperature; // 1/100 °C
+    uint16_t humidity; // 1/100 %
+    uint32_t pressure; // 1/100 hPa
+    uint32_t consumedLastDay; // mWh
+    uint32_t harvestedLastDay; // mWh
+    uint16_t stations;
+    uint32_t radioCoreLoops;
+} BinaryStatusPayload;
+
+// Followed by the raw packet, without terminator
+typedef struct __attribute__((packed)) {
+    uint32_t time; // Unix time
+    uint32_t count;
+    int16_t snr; // 1/100 dB
+    int16_t rssi; // 1/100 dBm
+    uint8_t digipeaterCount;
+    char callsign[BINARY_CALLSIGN_LENGTH];
+    char digipeaterCallsign[BINARY_CALLSIGN_LENGTH];
+} BinaryStationPayload;
+
+// Type, length and payload then CRC-16/CCITT, COBS encoded between two 0x00 delimiters.
+// The leading one ends any text written before on the same link.
+class BinaryFrame {
+public:
+    // Size written, 0 if the payload is too long
+    static size_t encode(BinaryMessageType type, const void *payload, uint16_t length, uint8_t *out);
+    // Continued from the CRC of the previous bytes if given
+    static uint16_t crc16(const uint8_t *data, size_t length, uint16_t crc = 0xFFFF);
+};
+
+// Fed byte by byte, resynchronised by each delimiter
+class BinaryFrameDecoder {
+public:
+    // true when a valid frame has just ended, then available until the next byte
+    bool push(uint8_t byte);
+
+    inline BinaryMessageType getType() const {
+        return static_cast<BinaryMessageType>(buffer[0]);
+    }
+
+    inline const uint8_t *getPayload() const {
+        return buffer + BINARY_FRAME_HEADER;
+    }
+
+    inline uint16_t getLength() const {
+        return length;
+    }
+
+    uint32_t errors = 0; // Frames too long or with a bad CRC
+private:
+    uint8_t buffer[BINARY_FRAME_ENCODED_MAX]{};
+    size_t size = 0;
+    uint16_t length = 0;
+    bool overflow = false;
+
+    bool decode();
+};
+
+#endif //RP2040_LORA_APRS_BINARYFRAME_H
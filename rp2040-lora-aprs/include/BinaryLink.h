@@ -0,0 +1,39 @@
+#ifndef RP2040_LORA_APRS_BINARYLINK_H
+#define RP2040_LORA_APRS_BINARYLINK_H
+
+#include <Arduino.h>
+#include "AprsHeardList.h"
+#include "BinaryFrame.h"
+#include "Timer.h"
+#include "config.h"
+
+class System;
+
+// Status and events pushed to the Linux board in binary frames on its UART, when enabled by linux.binaryEnabled.
+// Commands still come in as text lines.
+class BinaryLink {
+public:
+    explicit BinaryLink(System *system);
+
+    // Status at interval and errors when they change
+    void loop();
+
+    // Sent even when not enabled, as asked by the binary command
+    void sendStatus();
+    void sendStations(uint32_t since);
+
+    void heard(const AprsHeard *station);
+    void watchdogFired(const char *name);
+private:
+    System *system;
+    Timer timerStatus = Timer(INTERVAL_BINARY_STATUS, true);
+    uint8_t lastErrors = 0;
+    uint8_t buffer[BINARY_FRAME_ENCODED_MAX]{};
+
+    bool isEnabled() const;
+    uint8_t getErrors() const;
+    void sendStation(BinaryMessageType type, const AprsHeard *station);
+    bool send(BinaryMessageType type, const void *payload, uint16_t length);
+};
+
+#endif //RP2040_LORA_APRS_BINARYLINK_H
@@ -2,6 +2,7 @@
 #define MONITORING_COMMAND_H
 
 #include <CommandParser.h>
+#include "Settings.h"
 
 class System;
 
@@ -16,6 +17,13 @@ public:
     char response[MyCommandParser::MAX_RESPONSE_SIZE]{};
 private:
     static System *system;
+    static Stream *stream; // Of the command being processed, nullptr when received by radio
+
+    // Configuration being imported, in RAM until committed
+    static Settings *imported;
+    static Stream *importStream;
+    static uint32_t lastImportLine;
+    static uint16_t importErrors;
 
     MyCommandParser parser;
 
@@ -27,9 +35,13 @@ private:
     static void doReboot(MyCommandParser::Argument *args, char *response);
     static void doDfu(MyCommandParser::Argument *args, char *response);
     static void doPrintJson(MyCommandParser::Argument *args, char *response);
+    static void doPrintJsonPart(MyCommandParser::Argument *args, char *response);
+    static void doPrintJsonSince(MyCommandParser::Argument *args, char *response);
+    static void doBinary(MyCommandParser::Argument *args, char *response);
     static void doPing(MyCommandParser::Argument *args, char *response);
     static void doGpioOutput(MyCommandParser::Argument *args, char *response);
     static void doSetSetting(MyCommandParser::Argument *args, char *response);
+    static void doConfig(MyCommandParser::Argument *args, char *response);
     static void doGetSetting(MyCommandParser::Argument *args, char *response);
     static void doMpptWatchdog(MyCommandParser::Argument *args, char *response);
     static void doMeshtasticAprs(MyCommandParser::Argument *args, char *response);
@@ -37,6 +49,8 @@ private:
     static void doGetBoxInfo(MyCommandParser::Argument *args, char *response);
     static void doGetError(MyCommandParser::Argument *args, char *response);
     static void doSetLora(MyCommandParser::Argument *args, char *response);
+    static void doLoraProfile(MyCommandParser::Argument *args, char *response);
+    static void doStats(MyCommandParser::Argument *args, char *response);
 
     static void doAprsQueryHelp(MyCommandParser::Argument *args, char *response);
     static void doAprsHeardWithoutDigi(MyCommandParser::Argument *args, char *response);
@@ -44,6 +58,12 @@ private:
     static void doAprsHeardSomeone(MyCommandParser::Argument *args, char *response);
     static void doAbout(MyCommandParser::Argument *args, char *response);
     static void doAprsPing(MyCommandParser::Argument *args, char *response);
+
+    static void printJson(uint32_t sections, uint32_t since, char *response);
+
+    static void importLine(char *line);
+    static void commitImport(char *response);
+    static void endImport();
 };
 
 #endif //MONITORING_COMMAND_H
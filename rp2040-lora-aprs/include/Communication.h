@@ -1,35 +1,97 @@
 #ifndef RP2040_LORA_APRS_COMMUNICATION_H
 #define RP2040_LORA_APRS_COMMUNICATION_H
 
+#include <atomic>
 #include <RadioLib.h>
 #include "Aprs.h"
+#include "Ax25.h"
+#include "Timer.h"
+#include "TxQueue.h"
+#include "Airtime.h"
+#include "DupeCache.h"
+#include "LoRaScheduler.h"
+#include "SpscQueue.h"
 #include "config.h"
 
 class System;
 
+enum CommunicationState {
+    LoRaReceiving,
+    LoRaWaitChannelFree,
+    LoRaChannelScan,
+    LoRaTransmitting,
+    LoRaAfterTransmit
+};
+
+// Frame built by the main core, queued for TX by the radio core
+typedef struct {
+    uint8_t data[TRX_BUFFER];
+    size_t size;
+    TxPriority priority;
+} TxRequest;
+
+// Frame decoded by the radio core, handled by the main core
+typedef struct {
+    AprsPacketLite packet;
+    float rssi;
+    float snr;
+} RxFrame;
+
+// The radio is owned by the second core: begin(), update() and queueFrame() only run there.
+// The main core sends and receives through two lock free queues, so its threads can't delay RX or digipeat.
 class Communication {
 public:
     explicit Communication(System *system);
 
+    // Radio core
     bool begin();
     void update();
-    void received(uint8_t * payload, uint16_t size, float rssi, float snr);
+    bool queueFrame(const uint8_t* payload, size_t size, TxPriority priority);
+    // Back to the APRS channel at the start of a cycle, after a change of the profiles
+    bool restartScheduler();
+
+    inline bool hasPendingWork() const {
+        return hasInterrupt || !txRequests.isEmpty();
+    }
+
+    // Main core
+    void processReceived();
+
+    inline bool hasReceived() const {
+        return !rxFrames.isEmpty();
+    }
 
-    bool sendMessage(const char* destination, const char* message, const char* ackToConfirm = nullptr);
+    bool sendMessage(const char* destination, const char* message, const char* ackToConfirm = nullptr, TxPriority priority = TxPriorityBeacon);
     bool sendPosition(const char* comment);
     bool sendStatus(const char* comment);
     bool sendTelemetry();
     bool sendTelemetryParams();
     bool sendItem(const char* name, char symbol, char symbolTable, const char* comment, double latitude, double longitude, uint16_t altitude, bool alive = true);
 
-    bool sendRaw(const uint8_t* payload, size_t size);
+    bool sendRaw(const uint8_t* payload, size_t size, TxPriority priority = TxPriorityKiss);
+    // Applied by the radio core, waits for its result
     bool changeLoRaSettings(float frequency, uint16_t bandwidth, uint8_t spreadingFactor, uint8_t codingRate, uint8_t outputPower);
+    // Stays on the profile until LORA_PROFILE_AUTO, applied by the radio core, waits for its result
+    bool holdLoRaProfile(int8_t profile);
 
     bool shouldSendTelemetryParams = false;
 
+    TxQueue txQueue;
+    Airtime airtime;
+    DupeCache dupeCache;
+    LoRaScheduler scheduler;
+    SpscQueue<TxRequest, TX_REQUEST_QUEUE_SIZE> txRequests;
+    SpscQueue<RxFrame, RX_FRAME_QUEUE_SIZE> rxFrames;
+    std::atomic<bool> digipeatOnlyDirect{false}; // Set by the load shedding, frames already digipeated are not
+
     inline bool hasError() const {
         return _hasError;
     }
+
+    inline bool isTransmitting() const {
+        return state != LoRaReceiving;
+    }
+
 private:
     static volatile bool hasInterrupt;
 
@@ -38,17 +100,50 @@ private:
     System* system;
 
     uint8_t buffer[TRX_BUFFER]{};
+    char bufferAx25Text[3 + AX25_TEXT_MAX(TRX_BUFFER)]{}; // AX.25 frame received, in the text format with its LoRa APRS bytes
+    uint8_t bufferAx25[TRX_BUFFER]{}; // Digipeat of an AX.25 frame
     AprsPacket aprsPacketTx{};
     AprsPacketLite aprsPacketRx{};
     SX1262 lora = new Module(LORA_CS, LORA_DIO1, LORA_RESET, LORA_BUSY, SPI1, SPISettings(4000000, MSBFIRST, SPI_MODE0));
     bool _hasError = false;
 
+    CommunicationState state = LoRaReceiving;
+    Timer timerState = Timer(0);
+    uint8_t channelScanTries = 0;
+    TxQueueFrame *frameTx = nullptr;
+    bool isDeferred = false;
+    SettingsLoRa requestedLoRa{};
+    SettingsLoRa activeLoRa{}; // Modulation the radio is on, for the time on air
+    int8_t requestedProfile = LORA_PROFILE_AUTO;
+
+    static bool applyRequestedLoRa(System *system);
+    static bool applyRequestedProfile(System *system);
+    bool applyLoRaSettings(const SettingsLoRa &settings);
+    bool updateScheduler();
+    bool switchProfile(uint8_t profile);
+
+    void received(uint8_t * payload, uint16_t size, float rssi, float snr);
+    void queueRequests();
     bool startReceive();
-    bool sendAprsFrame();
-    bool send(size_t size);
+    bool sendAprsFrame(TxPriority priority = TxPriorityBeacon);
+    bool digipeat(const uint8_t *payload, size_t size, bool asAx25);
+    void startNext();
     void sent();
-    bool isChannelActive();
+    void abortTransmit();
     void prepareTelemetry();
+
+    uint16_t readInterrupt();
+    // The frame received on RX done, else listening again
+    void readReceived(uint16_t irqFlags);
+    void updateTransmit(uint16_t irqFlags);
+    void waitEndOfTransmit();
+    void startChannelScan();
+    void channelScanned(int16_t result);
+    void startTransmit();
+
+    inline bool isListening() const {
+        return state == LoRaReceiving || state == LoRaWaitChannelFree || state == LoRaAfterTransmit;
+    }
 };
 
 #endif //RP2040_LORA_APRS_COMMUNICATION_H
@@ -0,0 +1,30 @@
+#ifndef RP2040_LORA_APRS_DUPECACHE_H
+#define RP2040_LORA_APRS_DUPECACHE_H
+
+#include <Arduino.h>
+#include "Aprs.h"
+#include "config.h"
+
+typedef struct {
+    uint32_t hash;
+    unsigned long seenAt;
+    bool used;
+} DupeCacheEntry;
+
+// Frames heard during the last DUPE_CACHE_WINDOW, by hash of source, destination and payload.
+// The path is left out as each digipeater changes it.
+class DupeCache {
+public:
+    static uint32_t hash(const AprsPacketLite *packet);
+
+    // Remember the frame, true if it was already heard in the window
+    bool isDuplicate(uint32_t hash);
+
+    uint32_t checked = 0;
+    uint32_t hits = 0;
+private:
+    DupeCacheEntry entries[DUPE_CACHE_SIZE]{};
+    uint8_t next = 0;
+};
+
+#endif //RP2040_LORA_APRS_DUPECACHE_H
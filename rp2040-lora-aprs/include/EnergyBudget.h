@@ -0,0 +1,68 @@
+#ifndef RP2040_LORA_APRS_ENERGYBUDGET_H
+#define RP2040_LORA_APRS_ENERGYBUDGET_H
+
+#include <Arduino.h>
+#include "config.h"
+
+enum EnergyConsumer {
+    EnergyIdle, // Board awake, radio in RX
+    EnergySleep, // Main core waiting for an event
+    EnergyTx,
+    EnergyLinux,
+    EnergyMeshtastic,
+    ENERGY_CONSUMER_COUNT
+};
+
+// Counters at the time of an energy measure, the budget keeps the previous ones
+typedef struct {
+    uint32_t time; // ms
+    uint64_t airtime; // ms
+    uint32_t framesSent;
+    uint64_t timeWaiting; // us
+    bool linuxPowered;
+    bool meshtasticPowered;
+    int16_t voltageBattery; // mV
+    int16_t currentBattery; // mA drawn by the loads
+    int16_t voltageSolar; // mV
+    int16_t currentSolar; // mA
+} EnergySample;
+
+// Battery energy drawn between two measures, split between the consumers, over a sliding day in buckets of one hour.
+// Only the total is measured: TX comes from its airtime, Linux and Meshtastic boards from the extra power learnt
+// while they were the only ones powered, and what is left goes to idle and sleep by their time.
+class EnergyBudget {
+public:
+    void add(const EnergySample &sample);
+
+    // mWh over the last 24 hours
+    uint32_t lastDay(EnergyConsumer consumer) const;
+    uint32_t lastDayConsumed() const;
+    uint32_t lastDayHarvested() const;
+
+    // mWh per frame sent, since boot
+    inline float perFrame() const {
+        return framesSent ? txTotal / static_cast<float>(framesSent) : 0;
+    }
+
+    // Learnt power drawn by a consumer, mW
+    inline float getPower(const EnergyConsumer consumer) const {
+        return power[consumer];
+    }
+private:
+    float buckets[ENERGY_BUDGET_HOURS][ENERGY_CONSUMER_COUNT]{};
+    float harvested[ENERGY_BUDGET_HOURS]{};
+    uint32_t hours[ENERGY_BUDGET_HOURS]{};
+
+    float power[ENERGY_CONSUMER_COUNT]{};
+    bool hasLearnt[ENERGY_CONSUMER_COUNT]{};
+    float txTotal = 0;
+    uint32_t framesSent = 0;
+
+    EnergySample previous{};
+    bool hasPrevious = false;
+
+    void learn(EnergyConsumer consumer, float value);
+    uint8_t bucket(uint32_t time);
+};
+
+#endif //RP2040_LORA_APRS_ENERGYBUDGET_H
@@ -0,0 +1,33 @@
+#ifndef RP2040_LORA_APRS_JSONSECTIONS_H
+#define RP2040_LORA_APRS_JSONSECTIONS_H
+
+#include <Arduino.h>
+
+// Objects of the JSON status, uptime and time are always written
+enum JsonSection : uint32_t {
+    JsonErrors = 1 << 0,
+    JsonAirtime = 1 << 1,
+    JsonTxQueue = 1 << 2,
+    JsonDupeCache = 1 << 3,
+    JsonEnergyBudget = 1 << 4,
+    JsonLoadShedding = 1 << 5,
+    JsonSleep = 1 << 6,
+    JsonRadioCore = 1 << 7,
+    JsonAprsHeardLog = 1 << 8,
+    JsonEnergy = 1 << 9,
+    JsonBox = 1 << 10,
+    JsonWeather = 1 << 11,
+    JsonAprsSender = 1 << 12,
+    JsonWatchdog = 1 << 13,
+    JsonRuntime = 1 << 14,
+    JsonAprsReceived = 1 << 15,
+    JsonAll = 0xFFFFFFFF
+};
+
+class JsonSections {
+public:
+    // Comma separated names of the JSON keys, "all" for everything, false if one of them is unknown
+    static bool parse(const char *list, uint32_t *sections);
+};
+
+#endif //RP2040_LORA_APRS_JSONSECTIONS_H
@@ -0,0 +1,92 @@
+#ifndef RP2040_LORA_APRS_KISSENGINE_H
+#define RP2040_LORA_APRS_KISSENGINE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "KissFrame.h"
+
+class System;
+
+enum KissCommand : uint8_t {
+    KissData = 0x00,
+    KissTxDelay = 0x01,
+    KissPersistence = 0x02,
+    KissSlotTime = 0x03,
+    KissTxTail = 0x04,
+    KissFullDuplex = 0x05,
+    KissSetHardware = 0x06,
+    KissReturn = 0x0F // 0xFF on the port 15
+};
+
+// Set by the host with the KISS commands. Only persistence and slot time are applied, to the channel access
+// after a free CAD: with LoRa the preamble already plays the part of TX delay and tail.
+typedef struct {
+    uint8_t txDelay; // 10 ms
+    uint8_t persistence; // Transmit when a random byte is at most this
+    uint8_t slotTime; // 10 ms
+    uint8_t txTail; // 10 ms
+    bool fullDuplex;
+} KissParameters;
+
+typedef struct {
+    uint32_t frames; // Data frames queued for TX
+    uint32_t commands;
+    uint32_t dropped; // Too long, empty, for another port or TX queue full
+    uint32_t overflows; // Bytes lost by the UART FIFO
+    uint32_t sent; // Frames to the host
+    uint32_t sentDropped; // TX ring full
+} KissStats;
+
+// KISS TNC on Serial2, for Dire Wolf or APRX on the Linux board. Radio core only.
+// The UART fills a FIFO from its interrupt and the frame is decoded byte by byte as it comes,
+// so a frame split over several loops or several frames in one read are all queued for TX.
+// Frames to the host are encoded in a ring written as the UART FIFO has room, the loop never waits for it to drain.
+class KissEngine {
+public:
+    explicit KissEngine(System *system);
+    void begin();
+    // Monitor and signal report from the settings
+    void reload();
+    void update();
+
+    // Frame received by LoRa, only if not APRS unless in monitor mode. Sent as AX.25 whatever its format on air
+    void received(const uint8_t *payload, size_t size, bool isAprs, float rssi, float snr);
+
+    inline bool hasPendingWork() const {
+        return Serial2.available() > 0 || txHead != txTail;
+    }
+
+    // Decision of the p-persistence after a free channel
+    bool shouldTransmit() const;
+
+    inline uint32_t getSlotTime() const {
+        return parameters.slotTime * 10;
+    }
+
+    KissParameters parameters{KISS_DEFAULT_TX_DELAY, KISS_DEFAULT_PERSISTENCE, KISS_DEFAULT_SLOT_TIME, 0, false};
+    KissStats stats{};
+private:
+    System *system;
+
+    KissFrameDecoder decoder;
+
+    bool monitor = false;
+    bool signalReport = false;
+
+    uint8_t ax25[TRX_BUFFER]{}; // Text frame heard, converted for the host
+    uint8_t encoded[KISS_ENCODED_MAX]{}; // Frame to the host before it is copied in the ring
+    uint8_t txRing[KISS_TX_RING_SIZE]{};
+    size_t txHead = 0;
+    size_t txTail = 0;
+
+    bool send(uint8_t command, const uint8_t *data, size_t size);
+    void drain();
+
+    void frameEnded();
+    void command(uint8_t command, const uint8_t *data, size_t size);
+    void setHardware(const uint8_t *data, size_t size);
+};
+
+static_assert(KISS_TX_RING_SIZE > 2 * KISS_ENCODED_MAX, "The ring must hold a frame and its signal report");
+
+#endif //RP2040_LORA_APRS_KISSENGINE_H
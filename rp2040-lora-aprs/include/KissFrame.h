@@ -0,0 +1,50 @@
+#ifndef RP2040_LORA_APRS_KISSFRAME_H
+#define RP2040_LORA_APRS_KISSFRAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include "config.h"
+
+// Without Arduino, also built by the fuzz and benchmark of the host in scripts/kiss-frame
+
+#define KISS_FEND 0xC0
+#define KISS_FESC 0xDB
+#define KISS_TFEND 0xDC
+#define KISS_TFESC 0xDD
+
+// Command byte then data, FEND and FESC escaped, between two FEND
+class KissFrame {
+public:
+    // out must hold KISS_ENCODED_MAX. Size written, 0 if longer than a LoRa frame
+    static size_t encode(uint8_t command, const uint8_t *data, size_t size, uint8_t *out);
+};
+
+// Fed byte by byte, the noise before the first FEND is skipped and empty frames between two FEND too
+class KissFrameDecoder {
+public:
+    // true when a frame has just ended, then available until the next byte
+    bool push(uint8_t byte);
+
+    // Command byte then data
+    inline const uint8_t *getFrame() const {
+        return frame;
+    }
+
+    inline size_t getLength() const {
+        return length;
+    }
+
+    // Longer than KISS_FRAME_MAX, only its start is kept
+    inline bool isOverflow() const {
+        return overflow;
+    }
+private:
+    uint8_t frame[KISS_FRAME_MAX]{};
+    size_t length = 0;
+    bool inFrame = false;
+    bool escaped = false;
+    bool overflow = false;
+    bool ended = false;
+};
+
+#endif //RP2040_LORA_APRS_KISSFRAME_H
@@ -0,0 +1,67 @@
+#ifndef RP2040_LORA_APRS_LORASCHEDULER_H
+#define RP2040_LORA_APRS_LORASCHEDULER_H
+
+#include <Arduino.h>
+#include "Settings.h"
+#include "config.h"
+
+#define LORA_PROFILE_APRS 0 // The APRS channel of lora.*
+#define LORA_PROFILE_AUTO (-1) // Not held, switched by the time slots
+
+typedef struct {
+    uint32_t received;
+    uint32_t sent;
+    uint64_t airtime; // ms
+    uint64_t time; // ms on the profile, up to the last switch
+} LoRaProfileStats;
+
+// Radio profiles switched on a table of time slots: the APRS channel for loraScheduler.aprsSlot, then each profile of
+// loraScheduler.profiles with a slot in their order, and again. Owned by the radio core like the radio.
+class LoRaScheduler {
+public:
+    // Profile to switch to now, LORA_PROFILE_AUTO to stay on the current one
+    int8_t update(const SettingsLoRaScheduler &settings);
+    // The radio is on the profile, its slot starts
+    void switched(uint8_t profile);
+
+    // Stays on the profile until LORA_PROFILE_AUTO is held
+    inline void hold(const int8_t profile) {
+        held = profile;
+    }
+
+    inline void received() {
+        stats[profile].received++;
+    }
+
+    inline void sent(const uint32_t airtime) {
+        stats[profile].sent++;
+        stats[profile].airtime += airtime;
+    }
+
+    inline uint8_t getProfile() const {
+        return profile;
+    }
+
+    inline int8_t getHeld() const {
+        return held;
+    }
+
+    // ms on the profile, including the current slot
+    uint64_t getTime(uint8_t profile) const;
+
+    // Modulation of lora.* replaced by the one of the profile
+    static void parameters(uint8_t profile, const Settings &settings, SettingsLoRa *out);
+    static const char *getName(uint8_t profile, const SettingsLoRaScheduler &settings);
+    // LORA_PROFILE_AUTO if unknown
+    static int8_t find(const char *name, const SettingsLoRaScheduler &settings);
+
+    LoRaProfileStats stats[LORA_PROFILES]{};
+private:
+    uint8_t profile = LORA_PROFILE_APRS;
+    int8_t held = LORA_PROFILE_AUTO;
+    unsigned long slotStart = 0;
+
+    static uint32_t slot(uint8_t profile, const SettingsLoRaScheduler &settings);
+};
+
+#endif //RP2040_LORA_APRS_LORASCHEDULER_H
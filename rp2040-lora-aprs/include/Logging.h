@@ -0,0 +1,28 @@
+#ifndef RP2040_LORA_APRS_LOGGING_H
+#define RP2040_LORA_APRS_LOGGING_H
+
+#include <ArduinoLog.h>
+
+// Highest level compiled in: calls above it are removed with their format strings, not only filtered at run time
+#ifndef LOG_LEVEL_COMPILE
+#define LOG_LEVEL_COMPILE LOG_LEVEL_TRACE
+#endif
+
+#if LOG_LEVEL_COMPILE >= LOG_LEVEL_TRACE
+#define LOG_TRACE(...) Log.traceln(__VA_ARGS__)
+#else
+#define LOG_TRACE(...) do {} while (false)
+#endif
+
+#if LOG_LEVEL_COMPILE >= LOG_LEVEL_VERBOSE
+#define LOG_VERBOSE(...) Log.verboseln(__VA_ARGS__)
+#define LOG_HEX_DUMP(tag, data, size) logHexDump(tag, data, size)
+#else
+#define LOG_VERBOSE(...) do {} while (false)
+#define LOG_HEX_DUMP(tag, data, size) do {} while (false)
+#endif
+
+// Lines of 16 bytes, in hexadecimal then as characters
+void logHexDump(const char *tag, const uint8_t *data, size_t size);
+
+#endif //RP2040_LORA_APRS_LOGGING_H
@@ -2,6 +2,7 @@
 #define RP2040_LORA_APRS_MYTHREAD_H
 
 #include "Thread.h"
+#include "RuntimeStats.h"
 #include "config.h"
 
 class System;
@@ -25,8 +26,11 @@ public:
     }
 
     inline uint64_t timeBeforeRun() const {
-        return _cached_next_run - millis();
+        const long remaining = static_cast<long>(_cached_next_run - millis());
+        return force || remaining < 0 ? 0 : remaining;
     }
+
+    RuntimeStats stats;
 protected:
     virtual bool init() {
         return true;
@@ -0,0 +1,45 @@
+#ifndef RP2040_LORA_APRS_RUNTIMESTATS_H
+#define RP2040_LORA_APRS_RUNTIMESTATS_H
+
+#include <Arduino.h>
+
+#define RUNTIME_STATS_BUCKETS 25 // Powers of 2 of microseconds, up to 33 seconds
+
+// Durations in microseconds. Percentiles come from a histogram of powers of 2, so they are an upper bound.
+class RuntimeStats {
+public:
+    // Budget of 0 for no overrun counting
+    void add(uint32_t duration, uint32_t budget = 0);
+    void reset();
+
+    uint32_t percentile(uint8_t percent) const;
+
+    inline uint32_t getMin() const {
+        return count ? min : 0;
+    }
+
+    inline uint32_t getMax() const {
+        return max;
+    }
+
+    inline uint32_t getAverage() const {
+        return count ? total / count : 0;
+    }
+
+    inline uint32_t getCount() const {
+        return count;
+    }
+
+    inline uint32_t getOverruns() const {
+        return overruns;
+    }
+private:
+    uint32_t histogram[RUNTIME_STATS_BUCKETS]{};
+    uint32_t count = 0;
+    uint32_t overruns = 0;
+    uint32_t min = UINT32_MAX;
+    uint32_t max = 0;
+    uint64_t total = 0;
+};
+
+#endif //RP2040_LORA_APRS_RUNTIMESTATS_H
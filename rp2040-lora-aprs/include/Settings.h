@@ -4,8 +4,7 @@
 #include <Arduino.h>
 #include "Aprs.h"
 #include "INA3221.h"
-
-#define APRS_CALLSIGNS_HEARD_NUMBER 30
+#include "config.h"
 
 typedef struct {
     float frequency;
@@ -16,8 +15,8 @@ typedef struct {
     bool txEnabled;
     bool watchdogTxEnabled;
     uint64_t intervalTimeoutWatchdogTx;
-
-    uint8_t reserved[8];
+    uint16_t dutyCycle; // Per mille of an hour, 0 for no limit
+    uint8_t frameFormat; // LoRaFrameFormat of the frames sent, both are received
 } SettingsLoRa;
 
 typedef struct {
@@ -40,8 +39,6 @@ typedef struct {
     uint64_t intervalPositionWeather;
     bool telemetryInPosition;
     uint16_t telemetrySequenceNumber;
-
-    uint8_t reserved[128];
 } SettingsAprs;
 
 typedef struct {
@@ -49,23 +46,17 @@ typedef struct {
     uint64_t timeout;
     uint64_t intervalFeed;
     uint16_t timeOff;
-
-    uint8_t reserved[8];
 } SettingsMpptWatchdog;
 
 typedef struct {
     bool enabled;
     uint64_t intervalCheck;
     uint8_t pin;
-
-    uint8_t reserved[8];
 } SettingsBoxOpened;
 
 typedef struct {
     bool enabled;
     uint64_t intervalCheck;
-
-    uint8_t reserved[8];
 } SettingsWeather;
 
 enum TypeEnergySensor { dummy, mpptchg, ina, adc };
@@ -78,8 +69,10 @@ typedef struct {
     ina3221_ch_t inaChannelSolar;
     uint16_t mpptPowerOnVoltage;
     uint16_t mpptPowerOffVoltage;
-
-    uint8_t reserved[8];
+    bool lightSleep; // Gate the clocks while both cores wait for an event
+    bool loadShedding;
+    uint8_t shedThresholds[LOAD_SHEDDING_TIERS]; // % of battery under which each tier is entered
+    uint8_t shedHysteresis; // % above the threshold to leave a tier
 } SettingsEnergy;
 
 typedef struct {
@@ -97,8 +90,6 @@ typedef struct {
     double latitude;
     double longitude;
     uint16_t altitude;
-
-    uint8_t reserved[128];
 } SettingsMeshtastic;
 
 typedef struct {
@@ -116,29 +107,34 @@ typedef struct {
     double latitude;
     double longitude;
     uint16_t altitude;
-
-    uint8_t reserved[128];
+    bool binaryEnabled; // Status and events pushed in binary frames on its UART
 } SettingsLinux;
 
 typedef struct {
     bool enabled;
     uint8_t wakeUpPin;
-
-    uint8_t reserved[8];
 } SettingsRtc;
 
 typedef struct {
-    char callsign[CALLSIGN_LENGTH];
-    time_t time;
-    float rssi;
-    float snr;
-    char content[MAX_PACKET_LENGTH];
-    uint64_t count;
-    char digipeaterCallsign[CALLSIGN_LENGTH];
-    uint8_t digipeaterCount;
-
-    uint8_t reserved[128];
-} SettingsAprsCallsignHeard;
+    bool monitor; // Every frame received is sent to the host, not only the ones which are not APRS
+    bool signalReport; // Followed by a SetHardware frame with its RSSI and SNR
+} SettingsKiss;
+
+typedef struct {
+    char name[LORA_PROFILE_NAME_LENGTH];
+    float frequency;
+    uint16_t bandwidth;
+    uint8_t spreadingFactor;
+    uint8_t codingRate;
+    uint8_t outputPower;
+    uint32_t slot; // ms on this profile in each cycle of the scheduler, 0 to leave it out
+} SettingsLoRaProfile;
+
+typedef struct {
+    bool enabled;
+    uint32_t aprsSlot; // ms on the APRS channel of lora.* in each cycle
+    SettingsLoRaProfile profiles[LORA_PROFILES - 1];
+} SettingsLoRaScheduler;
 
 typedef struct {
     SettingsLoRa lora;
@@ -152,9 +148,8 @@ typedef struct {
     SettingsRtc rtc;
     bool useInternalWatchdog;
     bool useSlowClock;
-    SettingsAprsCallsignHeard aprsCallsignsHeard[APRS_CALLSIGNS_HEARD_NUMBER];
-
-    uint8_t reserved[512];
+    SettingsKiss kiss;
+    SettingsLoRaScheduler loraScheduler;
 } Settings;
 
 #endif //RP2040_LORA_APRS_SETTINGS_H
@@ -0,0 +1,36 @@
+#ifndef RP2040_LORA_APRS_SETTINGSFILE_H
+#define RP2040_LORA_APRS_SETTINGSFILE_H
+
+#include <LittleFS.h>
+#include "Settings.h"
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t fields;
+    uint32_t length; // Bytes of records after the header
+    uint32_t crc; // CRC32 of the records
+} SettingsFileHeader;
+
+// Settings persisted field by field: a header then records of tag, length and value.
+// Every field of the registry is written, so a default changed by a later firmware never replaces a saved value.
+// Only the fields added after the file was written take the default of the firmware.
+// Fields are found by tag, so they can be added, removed or moved in Settings without touching the ones saved.
+class SettingsFile {
+public:
+    // Records over the defaults already in settings, which are untouched if the file is missing or corrupted
+    static bool load(Settings *settings);
+    // Written to a temporary file then renamed over the previous one, nothing is written if the content is the same
+    static bool save(const Settings *settings);
+    // From the raw struct of /config.dat, over the defaults already in settings
+    static bool migrate(Settings *settings);
+    static void removeLegacy();
+private:
+    static uint32_t lastCrc; // Of the file on flash
+    static bool isWritten;
+
+    static uint32_t crc32(uint32_t crc, const uint8_t *data, size_t size);
+    static uint32_t writeRecords(File *file, const Settings *settings, uint16_t *count, uint32_t *length);
+};
+
+#endif //RP2040_LORA_APRS_SETTINGSFILE_H
@@ -0,0 +1,143 @@
+#ifndef RP2040_LORA_APRS_SETTINGSLEGACY_H
+#define RP2040_LORA_APRS_SETTINGSLEGACY_H
+
+#include "Settings.h"
+
+// Raw layout of /config.dat, written as is before the tagged settings file. Frozen: only read to migrate.
+// The trailing reserved of the root held the heard list, see AprsHeardList::migrate().
+
+typedef struct {
+    float frequency;
+    uint16_t bandwidth;
+    uint8_t spreadingFactor;
+    uint8_t codingRate;
+    uint8_t outputPower;
+    bool txEnabled;
+    bool watchdogTxEnabled;
+    uint64_t intervalTimeoutWatchdogTx;
+
+    uint8_t reserved[8];
+} SettingsLegacyLoRa;
+
+typedef struct {
+    char call[CALLSIGN_LENGTH];
+    char destination[CALLSIGN_LENGTH];
+    char path[CALLSIGN_LENGTH * MAX_PATH];
+    char comment[MESSAGE_LENGTH];
+    char status[MESSAGE_LENGTH];
+    char symbol;
+    char symbolTable;
+    double latitude;
+    double longitude;
+    uint16_t altitude;
+    bool digipeaterEnabled;
+    bool telemetryEnabled;
+    uint64_t intervalTelemetry;
+    bool statusEnabled;
+    uint64_t intervalStatus;
+    bool positionWeatherEnabled;
+    uint64_t intervalPositionWeather;
+    bool telemetryInPosition;
+    uint16_t telemetrySequenceNumber;
+
+    uint8_t reserved[128];
+} SettingsLegacyAprs;
+
+typedef struct {
+    bool enabled;
+    uint64_t timeout;
+    uint64_t intervalFeed;
+    uint16_t timeOff;
+
+    uint8_t reserved[8];
+} SettingsLegacyMpptWatchdog;
+
+typedef struct {
+    bool enabled;
+    uint64_t intervalCheck;
+    uint8_t pin;
+
+    uint8_t reserved[8];
+} SettingsLegacyBoxOpened;
+
+typedef struct {
+    bool enabled;
+    uint64_t intervalCheck;
+
+    uint8_t reserved[8];
+} SettingsLegacyWeather;
+
+typedef struct {
+    uint64_t intervalCheck;
+    TypeEnergySensor type;
+    uint8_t adcPin;
+    ina3221_ch_t inaChannelBattery;
+    ina3221_ch_t inaChannelSolar;
+    uint16_t mpptPowerOnVoltage;
+    uint16_t mpptPowerOffVoltage;
+
+    uint8_t reserved[8];
+} SettingsLegacyEnergy;
+
+typedef struct {
+    bool watchdogEnabled;
+    uint64_t intervalTimeoutWatchdog;
+    uint8_t pin;
+    bool i2cSlaveEnabled;
+    uint8_t i2cSlaveAddress;
+    bool aprsSendItemEnabled;
+    uint64_t intervalSendItem;
+    char itemName[TELEMETRY_NAME_LENGTH];
+    char itemComment[MESSAGE_LENGTH];
+    char symbol;
+    char symbolTable;
+    double latitude;
+    double longitude;
+    uint16_t altitude;
+
+    uint8_t reserved[128];
+} SettingsLegacyMeshtastic;
+
+typedef struct {
+    bool watchdogEnabled;
+    uint64_t intervalTimeoutWatchdog;
+    uint8_t pin;
+    uint8_t nprPin;
+    uint8_t wifiPin;
+    bool aprsSendItemEnabled;
+    uint64_t intervalSendItem;
+    char itemName[TELEMETRY_NAME_LENGTH];
+    char itemComment[MESSAGE_LENGTH];
+    char symbol;
+    char symbolTable;
+    double latitude;
+    double longitude;
+    uint16_t altitude;
+
+    uint8_t reserved[128];
+} SettingsLegacyLinux;
+
+typedef struct {
+    bool enabled;
+    uint8_t wakeUpPin;
+
+    uint8_t reserved[8];
+} SettingsLegacyRtc;
+
+typedef struct {
+    SettingsLegacyLoRa lora;
+    SettingsLegacyEnergy energy;
+    SettingsLegacyAprs aprs;
+    SettingsLegacyMeshtastic meshtastic;
+    SettingsLegacyMpptWatchdog mpptWatchdog;
+    SettingsLegacyWeather weather;
+    SettingsLegacyBoxOpened boxOpened;
+    SettingsLegacyLinux linux;
+    SettingsLegacyRtc rtc;
+    bool useInternalWatchdog;
+    bool useSlowClock;
+
+    uint8_t reserved[512];
+} SettingsLegacy;
+
+#endif //RP2040_LORA_APRS_SETTINGSLEGACY_H
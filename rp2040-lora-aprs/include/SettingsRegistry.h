@@ -0,0 +1,70 @@
+#ifndef RP2040_LORA_APRS_SETTINGSREGISTRY_H
+#define RP2040_LORA_APRS_SETTINGSREGISTRY_H
+
+#include <JsonWriter.h>
+#include "Settings.h"
+
+class System;
+
+#define SETTING_NO_LEGACY 0xFFFF // Field added after the raw config file
+#define SETTING_VALUE_LENGTH 128 // Value as text when printed, longer ones are cut
+
+enum SettingType : uint8_t {
+    SettingBool, // '1' for true, anything else for false
+    SettingUnsigned, // Integer or enum of the size of the field
+    SettingHex, // Unsigned shown in hexadecimal
+    SettingFloat,
+    SettingDouble,
+    SettingChar,
+    SettingText // Refused if it does not fit with its terminator
+};
+
+enum SettingApply : uint8_t {
+    SettingApplied,
+    SettingNotApplied,
+    SettingNeedsReboot
+};
+
+typedef struct {
+    const char *key;
+    uint16_t tag; // In the settings file, never reused once a field is removed
+    SettingType type;
+    uint16_t offset; // In Settings
+    uint16_t legacyOffset; // In SettingsLegacy
+    uint16_t size;
+    double min; // Range of numbers, ignored for the other types
+    double max;
+    SettingApply (*apply)(System *system); // After a change by set, nullptr when the value is only read where used
+} SettingDescriptor;
+
+// Every setting in one table sorted by key, used by set, get, the print of the configuration, its JSON and the settings file
+class SettingsRegistry {
+public:
+    // Binary search on the key, nullptr if unknown
+    static const SettingDescriptor *find(const char *key);
+    // Only the first length characters of key, as the key at the start of a line
+    static const SettingDescriptor *find(const char *key, size_t length);
+    // Linear search, only done when the settings file is read
+    static const SettingDescriptor *findByTag(uint16_t tag);
+
+    static const SettingDescriptor *first();
+    static const SettingDescriptor *end();
+
+    // false if the value is not valid for the setting, which is then unchanged
+    static bool parse(const SettingDescriptor *setting, Settings *settings, const char *value);
+    // parse() in the settings of the system, the field written by the radio core which reads them too
+    static bool set(System *system, const SettingDescriptor *setting, const char *value);
+    static void format(const SettingDescriptor *setting, const Settings *settings, char *buffer, size_t size);
+
+    static void print(const Settings *settings);
+    static void writeJson(JsonWriter *writer, const Settings *settings);
+
+    // One "key value" line per setting, texts and chars between quotes with \" and \\ escaped
+    static void writeText(Print *out, const Settings *settings);
+    // Line written by writeText(), nullptr if the key is unknown or the value not valid
+    static const SettingDescriptor *parseLine(Settings *settings, char *line);
+    // Fields of staged which differ copied to the settings of the system by the radio core, each apply callback run once at the end
+    static SettingApply commit(System *system, const Settings *staged, uint16_t *changed);
+};
+
+#endif //RP2040_LORA_APRS_SETTINGSREGISTRY_H
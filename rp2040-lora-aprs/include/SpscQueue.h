@@ -0,0 +1,55 @@
+#ifndef RP2040_LORA_APRS_SPSCQUEUE_H
+#define RP2040_LORA_APRS_SPSCQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+
+// Lock free queue between the two cores: one of them only pushes, the other one only pops.
+// Slots are filled and read in place, so a frame is copied once.
+template<typename T, uint8_t N>
+class SpscQueue {
+    static_assert(N > 0 && N <= 128 && (N & (N - 1)) == 0, "Size must be a power of 2");
+public:
+    // Producer: slot to fill then commit(), nullptr if the queue is full
+    T *reserve() {
+        const uint8_t position = head.load(std::memory_order_relaxed);
+
+        if (static_cast<uint8_t>(position - tail.load(std::memory_order_acquire)) >= N) {
+            full++;
+            return nullptr;
+        }
+
+        return &slots[position % N];
+    }
+
+    void commit() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Consumer: oldest slot, kept until pop(), nullptr if the queue is empty
+    T *front() {
+        const uint8_t position = tail.load(std::memory_order_relaxed);
+
+        if (position == head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+
+        return &slots[position % N];
+    }
+
+    void pop() {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    inline bool isEmpty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    uint32_t full = 0; // Pushes refused, written by the producer only
+private:
+    T slots[N]{};
+    std::atomic<uint8_t> head{0};
+    std::atomic<uint8_t> tail{0};
+};
+
+#endif //RP2040_LORA_APRS_SPSCQUEUE_H
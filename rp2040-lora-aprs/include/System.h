@@ -1,17 +1,23 @@
 #ifndef RP2040_LORA_APRS_SYSTEM_H
 #define RP2040_LORA_APRS_SYSTEM_H
 
+#include <atomic>
 #include <cstdint>
 #include <ThreadController.h>
 #include <DS3231.h>
 #include <JsonWriter.h>
-#include <kiss.h>
 
+#include "AprsHeardList.h"
+#include "BinaryLink.h"
 #include "Communication.h"
+#include "EnergyBudget.h"
+#include "RuntimeStats.h"
 #include "Timer.h"
 #include "config.h"
 #include "Command.h"
 #include "GpioPin.h"
+#include "KissEngine.h"
+#include "JsonSections.h"
 #include "Threads/EnergyThread.h"
 #include "Threads/WeatherThread.h"
 #include "Threads/Watchdog/WatchdogSlaveMpptChgThread.h"
@@ -22,7 +28,9 @@
 #include "Threads/Send/SendTelemetriesThread.h"
 
 #include "Settings.h"
+#include "SettingsFile.h"
 #include "Threads/LdrBoxOpenedThread.h"
+#include "Threads/LoadSheddingThread.h"
 #include "Threads/Send/MeshtasticSendAprsThread.h"
 #include "Threads/Send/LinuxSendAprsThread.h"
 
@@ -32,17 +40,28 @@ public:
 
     bool begin();
     void loop();
+    // Second core: radio, KISS and I2C slave
+    void beginRadio();
+    void loopRadio();
+    // From the main core, runs the function on the radio core between two of its loops and waits for its result
+    bool runOnRadioCore(bool (*function)(System *system));
+
+    inline bool isStarted() const {
+        return started.load(std::memory_order_acquire);
+    }
 
     void setClock(bool slow);
     void setTimeToInternalRtc(time_t unixtime);
     bool resetSettings();
     bool saveSettings();
-    void addAprsFrameReceivedToHistory(const AprsPacketLite *packet, float snr, float rssi);
     void planReboot();
     void planDfu();
     void printSettings();
-    void printJson(bool onUsb);
-    void sendToKissInterface(const uint8_t* data, size_t size);
+    void printSettingsJson(bool onUsb);
+    // Only the sections asked, and the stations heard from since (unix time)
+    void printJson(bool onUsb, uint32_t sections = JsonAll, uint32_t since = 0);
+    void printStats();
+    MyThread *getSlowestThread();
 
     GpioPin* getGpio(uint8_t pin);
     DateTime getDateTime() const;
@@ -55,8 +74,20 @@ public:
         return !isSlowClock;
     }
 
+    // us the main core waited for an event, asleep with light sleep
+    inline uint64_t getTimeWaiting() const {
+        return timeWaiting;
+    }
+
+    inline uint32_t getRadioCoreLoops() const {
+        return radioCoreLoops.load(std::memory_order_relaxed);
+    }
+
     Settings settings{};
-    SettingsAprsCallsignHeard *lastAprsHeard = nullptr;
+    AprsHeardList aprsHeard;
+    EnergyBudget energyBudget;
+    RuntimeStats loopStats; // Work of an iteration, without the wait for the next event
+    RuntimeStats loopPeriodStats; // From the start of an iteration to the next one
 
     LdrBoxOpenedThread *ldrBoxOpenedThread{};
     EnergyThread *energyThread{};
@@ -68,9 +99,12 @@ public:
     SendTelemetriesThread *sendTelemetriesThread{};
     MeshtasticSendAprsThread *sendMeshtasticAprsThread{};
     LinuxSendAprsThread *sendLinuxAprsThread{};
+    LoadSheddingThread *loadSheddingThread{};
 
     Communication communication;
     Command command;
+    BinaryLink binaryLink;
+    KissEngine kiss; // Radio core only
     GpioPin gpioLed = GpioPin(LED_BUILTIN, OUTPUT_2MA);
     GpioPin *gpiosPin[MAX_GPIO_USED]{};
 
@@ -88,13 +122,32 @@ private:
     Timer timerDfu = Timer(TIME_BEFORE_REBOOT);
     Timer timerReboot = Timer(TIME_BEFORE_REBOOT);
     Timer timerPrintJson = Timer(INTERVAL_PRINT_JSON_USB, true);
+    uint32_t lastLoopStart = 0;
+    uint64_t timeWaiting = 0;
     JsonWriter serialJsonWriter = JsonWriter(&Serial);
     JsonWriter serialLinuxJsonWriter = JsonWriter(&Serial1);
 
-    kiss_packet_t kissPacket;
+    static volatile bool hasRtcWakeUp;
+    uint32_t rtcWakeUps = 0;
+
+    static void onRtcWakeUp();
+
+    std::atomic<bool> started{false};
+    std::atomic<bool (*)(System *)> radioCoreFunction{nullptr};
+    volatile bool radioCoreResult = false;
+    std::atomic<uint32_t> radioCoreLoops{0};
+    std::atomic<bool> kissReceived{false}; // Set by the radio core, the main core feeds the Linux watchdog with it
+    uint32_t lastRadioCoreLoops = 0;
+    uint32_t lastRadioCoreProgress = 0;
 
     bool loadSettings();
     void setDefaultSettings();
+    uint32_t timeBeforeNextEvent();
+    bool hasPendingEvent();
+    void waitNextEvent();
+    bool hasPendingRadioEvent();
+    void waitNextRadioEvent();
+    bool isRadioCoreAlive();
 };
 
 #endif //RP2040_LORA_APRS_SYSTEM_H
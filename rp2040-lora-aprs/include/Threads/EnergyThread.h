@@ -12,6 +12,10 @@ public:
 
     uint8_t getBatteryPercentage() const;
 
+    inline bool hasBatteryPercentage() const {
+        return numOcvPoints > 0 && ocv != nullptr;
+    }
+
     inline int16_t getVoltageBattery() const {
         return vb;
     }
@@ -0,0 +1,33 @@
+#ifndef RP2040_LORA_APRS_LOADSHEDDINGTHREAD_H
+#define RP2040_LORA_APRS_LOADSHEDDINGTHREAD_H
+
+#include "MyThread.h"
+
+class System;
+
+// Lowers the consumption in tiers as the battery discharges: longer beacon intervals, then the boards powered
+// by the tracker off, then only the frames heard directly are digipeated. Each tier is left once the battery
+// is above its threshold plus an hysteresis, one at a time.
+class LoadSheddingThread : public MyThread {
+public:
+    explicit LoadSheddingThread(System *system);
+
+    // Beacon intervals from the settings, lengthened by the current tier
+    void applyIntervals() const;
+
+    inline uint8_t getTier() const {
+        return tier;
+    }
+protected:
+    bool runOnce() override;
+private:
+    uint8_t tier = 0;
+    bool wasNprOn = false;
+    bool wasWifiOn = false;
+
+    uint8_t targetTier(uint8_t percentage) const;
+    void setTier(uint8_t newTier);
+    void setPowerOff(bool off);
+};
+
+#endif //RP2040_LORA_APRS_LOADSHEDDINGTHREAD_H
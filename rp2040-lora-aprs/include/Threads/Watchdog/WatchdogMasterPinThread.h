@@ -10,6 +10,8 @@ public:
     explicit WatchdogMasterPinThread(System *system, const char* name, GpioPin *gpio, unsigned long intervalCheck, bool enabled);
     void sleep(uint64_t millis);
     bool feed() override;
+    // Kept off whatever the dog, until powered on again
+    void setPoweredOff(bool off);
 
     inline bool isGpioOn() const {
         return gpio->getState();
@@ -21,6 +23,7 @@ private:
     GpioPin *gpio;
     Timer timerSleep;
     bool wantToSleep = false;
+    bool poweredOff = false;
 };
 
 
@@ -0,0 +1,62 @@
+#ifndef RP2040_LORA_APRS_TXQUEUE_H
+#define RP2040_LORA_APRS_TXQUEUE_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// Lower value is sent first
+enum TxPriority {
+    TxPriorityAck,
+    TxPriorityDigipeat,
+    TxPriorityKiss,
+    TxPriorityBeacon,
+    TX_PRIORITY_COUNT
+};
+
+typedef struct {
+    uint8_t data[TRX_BUFFER];
+    size_t size;
+    TxPriority priority;
+    uint32_t sequence;
+    unsigned long enqueuedAt;
+    bool used;
+    bool inFlight;
+} TxQueueFrame;
+
+typedef struct {
+    uint32_t enqueued;
+    uint32_t sent;
+    uint32_t dropped[TX_PRIORITY_COUNT];
+    uint8_t maxDepth;
+    uint32_t waitTotal;
+    uint32_t waitMax;
+} TxQueueStats;
+
+class TxQueue {
+public:
+    // Slot to fill with the frame, nullptr if the queue is full of frames with a higher or same priority
+    TxQueueFrame *push(TxPriority priority);
+    // Only KISS frames when kissOnly, the in flight one whatever its priority
+    TxQueueFrame *next(bool kissOnly = false);
+    void pop(TxQueueFrame *frame, bool sent = true);
+
+    inline uint8_t depth() const {
+        return count;
+    }
+
+    inline bool isEmpty() const {
+        return count == 0;
+    }
+
+    inline uint32_t waitAverage() const {
+        return stats.sent ? stats.waitTotal / stats.sent : 0;
+    }
+
+    TxQueueStats stats{};
+private:
+    TxQueueFrame frames[TX_QUEUE_SIZE]{};
+    uint8_t count = 0;
+    uint32_t sequence = 0;
+};
+
+#endif //RP2040_LORA_APRS_TXQUEUE_H
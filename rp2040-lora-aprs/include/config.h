@@ -14,6 +14,34 @@
 
 #define LORA_PREAMBLE_LENGTH 8
 #define TRX_BUFFER 253 // 256 - 3 because 3 bytes for LoRa APRS
+#define KISS_FRAME_MAX (TRX_BUFFER + 1) // Command byte and the longest frame sent
+#define KISS_ENCODED_MAX (2 * KISS_FRAME_MAX + 2) // Every byte escaped, between two FEND
+#define KISS_RX_FIFO_SIZE 2048 // Bytes of the UART filled by its interrupt, several frames while the radio is busy
+#define KISS_FIFO_READ_MAX 512 // Bytes decoded in one loop of the radio core
+#define KISS_TX_RING_SIZE 2048 // Frames encoded for the host, written as the UART FIFO has room
+#define KISS_DEFAULT_TX_DELAY 50 // 500 ms
+#define KISS_DEFAULT_PERSISTENCE 255 // Always transmit on a free channel until the host sets it
+#define KISS_DEFAULT_SLOT_TIME 10 // 100 ms
+#define TX_QUEUE_SIZE 8
+#define TX_REQUEST_QUEUE_SIZE 8 // Power of 2, frames sent by the main core not yet queued by the radio core
+#define RX_FRAME_QUEUE_SIZE 4 // Power of 2, frames received by the radio core not yet handled by the main core
+#define AIRTIME_WINDOW_MINUTES 60
+#define AIRTIME_BEACON_BUDGET_PERCENT 80 // Beacons are dropped above this part of the duty cycle
+#define LORA_PROFILES 3 // The APRS channel of lora.* then the profiles of the scheduler
+#define LORA_PROFILE_NAME_LENGTH 10
+#define LORA_SCHEDULER_SLOT_MIN 10000 // 10 seconds, shorter slots are lengthened to it
+#define DUPE_CACHE_SIZE 32
+#define DUPE_CACHE_WINDOW 30000 // 30 seconds
+#define APRS_HEARD_STATIONS 256
+#define APRS_HEARD_INDEX_SIZE 512 // Power of 2, twice the stations to keep probes short
+#define APRS_HEARD_PACKETS 12 // Last raw packets kept, shared by all stations
+#define APRS_HEARD_LOG_MAX_RECORDS (APRS_HEARD_STATIONS * 2) // Compacted above
+#define ENERGY_BUDGET_HOURS 24
+#define ENERGY_BUDGET_LEARNING 8 // Measures averaged in the learnt power of a consumer
+#define ENERGY_TX_POWER 400 // mW drawn from the battery while sending at 22dBm, regulator included
+#define LOAD_SHEDDING_TIERS 3 // Each one doubles the beacon intervals
+#define LOAD_SHEDDING_TIER_POWER_OFF 2 // Linux board, NPR and WiFi powered off from this tier
+#define LOAD_SHEDDING_TIER_DIGIPEAT_DIRECT 3 // Only frames heard directly are digipeated from this tier
 
 #define DISABLE_SLOW_CLOCK false
 #define MAX_GPIO_USED 10
@@ -21,11 +49,21 @@
 #define TIME_SET_MPPT_WATCHDOG_DFU 120000 // 2 minutes
 #define INTERVAL_BLINKER 1000
 #define INTERVAL_PRINT_JSON_USB 30000
+#define INTERVAL_BINARY_STATUS 60000 // Status pushed to the Linux board, events are pushed at once
+#define LOOP_MAX_WAIT 1000 // Longest sleep between two loops, the timers are checked at least this often
+#define LOOP_BUSY_WAIT 10 // Sleep between two loops while frames are in the TX queue
+#define TIME_RADIO_CORE_STALLED 5000 // The watchdog is no more reset when the radio core didn't loop for this time
+#define INTERVAL_FLUSH_APRS_HEARD 300000 // 5 minutes
 #define TIME_AFTER_BOOT 90000 // 1 minute 30
+#define THREAD_RUN_BUDGET 100 // ms, a longer run delays the handling of a received frame
 #define TIME_WAIT_TOGGLE_WATCHDOG_MASTER 5000 // 5 seconds
 #define TIME_BEFORE_REBOOT 5000 // 5 seconds
+#define TIME_CONFIG_IMPORT 30000 // An import without a line for this time is dropped
 #define TIME_WAIT_CHANNEL_ACTIVE 1000
+#define TIME_CHANNEL_SCAN_TIMEOUT 1000
 #define TIME_AFTER_TX 1000
+#define TIME_TX_DISABLED 1000
+#define MAX_CHANNEL_SCAN_TRIES 3
 
 #define ENERGY_ADC_BATTERY_SENSE_SAMPLES 15
 //  ratio of voltage divider = 3.0 (R17=200k, R18=100k)
@@ -33,8 +71,7 @@
 #define ENERGY_ADC_MULTIPLIER 3.1 // 3.0 + a bit for being optimistic
 #define AREF_VOLTAGE 3.3
 
-extern char bufferText[BUFFER_LENGTH];
-extern uint8_t buffer[BUFFER_LENGTH];
+extern char bufferText[BUFFER_LENGTH]; // Main core only
 
 #endif
 
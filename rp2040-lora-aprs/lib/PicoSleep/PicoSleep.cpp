@@ -1,6 +1,8 @@
 #include "PicoSleep.h"
 #include "sleep.h"
 #include "Arduino.h"
+#include "hardware/structs/clocks.h"
+#include "hardware/structs/scb.h"
 
 static bool awake;
 
@@ -51,4 +53,37 @@ void cpuDeepSleep(uint32_t msecs)
 
     /* Set RP2040 in dormant mode. Will not wake up. */
     //  xosc_dormant();
-}
\ No newline at end of file
+}
+
+void lightSleepGateClocks(const bool keepUsb)
+{
+    // Timer and watchdog for the thread deadlines, GPIO for DIO1 and the RTC pin, UARTs, I2C slave and RTC
+    clocks_hw->sleep_en0 = CLOCKS_SLEEP_EN0_CLK_SYS_CLOCKS_BITS
+            | CLOCKS_SLEEP_EN0_CLK_SYS_BUSFABRIC_BITS
+            | CLOCKS_SLEEP_EN0_CLK_SYS_BUSCTRL_BITS
+            | CLOCKS_SLEEP_EN0_CLK_SYS_IO_BITS
+            | CLOCKS_SLEEP_EN0_CLK_SYS_PADS_BITS
+            | CLOCKS_SLEEP_EN0_CLK_SYS_SIO_BITS
+            | CLOCKS_SLEEP_EN0_CLK_SYS_I2C1_BITS
+            | CLOCKS_SLEEP_EN0_CLK_SYS_RTC_BITS
+            | CLOCKS_SLEEP_EN0_CLK_RTC_RTC_BITS
+            | CLOCKS_SLEEP_EN0_CLK_SYS_PSM_BITS
+            | CLOCKS_SLEEP_EN0_CLK_SYS_RESETS_BITS
+            | CLOCKS_SLEEP_EN0_CLK_SYS_VREG_AND_CHIP_RESET_BITS
+            | CLOCKS_SLEEP_EN0_CLK_SYS_PLL_SYS_BITS
+            | (keepUsb ? CLOCKS_SLEEP_EN0_CLK_SYS_PLL_USB_BITS : 0);
+    clocks_hw->sleep_en1 = CLOCKS_SLEEP_EN1_CLK_SYS_TIMER_BITS
+            | CLOCKS_SLEEP_EN1_CLK_SYS_WATCHDOG_BITS
+            | CLOCKS_SLEEP_EN1_CLK_SYS_XOSC_BITS
+            | CLOCKS_SLEEP_EN1_CLK_SYS_SYSCFG_BITS
+            | CLOCKS_SLEEP_EN1_CLK_SYS_UART0_BITS
+            | CLOCKS_SLEEP_EN1_CLK_PERI_UART0_BITS
+            | CLOCKS_SLEEP_EN1_CLK_SYS_UART1_BITS
+            | CLOCKS_SLEEP_EN1_CLK_PERI_UART1_BITS
+            | (keepUsb ? CLOCKS_SLEEP_EN1_CLK_SYS_USBCTRL_BITS | CLOCKS_SLEEP_EN1_CLK_USB_USBCTRL_BITS : 0);
+}
+
+void lightSleepEnableCore()
+{
+    scb_hw->scr |= M0PLUS_SCR_SLEEPDEEP_BITS;
+}
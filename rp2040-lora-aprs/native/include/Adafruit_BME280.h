@@ -0,0 +1,39 @@
+#ifndef RP2040_LORA_APRS_NATIVE_ADAFRUIT_BME280_H
+#define RP2040_LORA_APRS_NATIVE_ADAFRUIT_BME280_H
+
+#include <Wire.h>
+
+// Host replacement: no sensor on the bus, begin() fails like on a board without it
+
+class Adafruit_BME280 {
+public:
+    enum sensor_sampling { SAMPLING_NONE, SAMPLING_X1, SAMPLING_X2, SAMPLING_X4, SAMPLING_X8, SAMPLING_X16 };
+    enum sensor_mode { MODE_SLEEP, MODE_FORCED, MODE_NORMAL = 3 };
+    enum sensor_filter { FILTER_OFF, FILTER_X2, FILTER_X4, FILTER_X8, FILTER_X16 };
+    enum standby_duration { STANDBY_MS_0_5, STANDBY_MS_10, STANDBY_MS_20, STANDBY_MS_62_5, STANDBY_MS_125, STANDBY_MS_250, STANDBY_MS_500, STANDBY_MS_1000 };
+
+    inline bool begin(uint8_t address = 0x77) {
+        return false;
+    }
+
+    inline void setSampling(sensor_mode, sensor_sampling, sensor_sampling, sensor_sampling, sensor_filter, standby_duration) {
+    }
+
+    inline bool takeForcedMeasurement() {
+        return false;
+    }
+
+    inline float readTemperature() {
+        return NAN;
+    }
+
+    inline float readPressure() {
+        return NAN;
+    }
+
+    inline float readHumidity() {
+        return NAN;
+    }
+};
+
+#endif //RP2040_LORA_APRS_NATIVE_ADAFRUIT_BME280_H
@@ -0,0 +1,127 @@
+#ifndef RP2040_LORA_APRS_NATIVE_ARDUINO_H
+#define RP2040_LORA_APRS_NATIVE_ARDUINO_H
+
+/*
+ * Minimal Arduino core for the host build (env:native).
+ * Only what the firmware and its portable dependencies use is provided.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <ctime>
+#include <cassert>
+#include <strings.h>
+
+#include "pgmspace.h"
+#include "WString.h"
+#include "Stream.h"
+#include "hardware/clocks.h"
+#include "hardware/watchdog.h"
+
+#define LED_BUILTIN 25
+#define PIN_LED LED_BUILTIN
+#define ADC_RESOLUTION 12
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+typedef uint8_t pin_size_t;
+typedef bool boolean;
+typedef uint8_t byte;
+
+typedef enum {
+    LOW = 0,
+    HIGH = 1,
+    CHANGE = 2,
+    FALLING = 3,
+    RISING = 4,
+} PinStatus;
+
+typedef enum {
+    INPUT = 0x0,
+    OUTPUT = 0x1,
+    INPUT_PULLUP = 0x2,
+    INPUT_PULLDOWN = 0x3,
+    OUTPUT_2MA = 0x4,
+    OUTPUT_4MA = 0x5,
+    OUTPUT_8MA = 0x6,
+    OUTPUT_12MA = 0x7,
+} PinMode;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long milliseconds);
+void delayMicroseconds(unsigned int microseconds);
+void yield();
+
+void pinMode(pin_size_t pin, PinMode mode);
+void digitalWrite(pin_size_t pin, int value);
+PinStatus digitalRead(pin_size_t pin);
+int analogRead(pin_size_t pin);
+void attachInterrupt(pin_size_t pin, void (*callback)(), PinStatus mode);
+void detachInterrupt(pin_size_t pin);
+
+long random(long max);
+long random(long min, long max);
+
+class RP2040 {
+public:
+    void wdt_begin(uint32_t delayMs);
+    void wdt_reset();
+    [[noreturn]] void reboot();
+    [[noreturn]] void rebootToBootloader();
+
+    inline uint32_t getCycleCount() const {
+        return micros() * 125;
+    }
+};
+
+extern RP2040 rp2040;
+
+// Host side serial port: USB is bound to stdin/stdout, UARTs can be bound to files by the runtime
+class SerialPort : public Stream {
+public:
+    explicit SerialPort(const char *name);
+
+    void begin(unsigned long baud);
+    void end();
+    bool setFIFOSize(size_t size);
+    bool overflow();
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    int availableForWrite() override;
+    void flush() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *data, size_t size) override;
+    using Print::write;
+
+    void bind(int inputFd, int outputFd);
+
+    explicit operator bool() const {
+        return true;
+    }
+private:
+    const char *name;
+    int inputFd = -1;
+    int outputFd = -1;
+    int peeked = -1;
+};
+
+extern SerialPort Serial;
+extern SerialPort Serial1;
+extern SerialPort Serial2;
+
+void setup();
+void loop();
+void setup1();
+void loop1();
+
+#endif //RP2040_LORA_APRS_NATIVE_ARDUINO_H
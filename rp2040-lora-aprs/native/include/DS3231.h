@@ -0,0 +1,63 @@
+#ifndef RP2040_LORA_APRS_NATIVE_DS3231_H
+#define RP2040_LORA_APRS_NATIVE_DS3231_H
+
+#include <Arduino.h>
+
+// Host replacement of northernwidget/DS3231: the RTC is the host clock
+
+class DateTime {
+public:
+    explicit DateTime(time_t unixtime = 0);
+    DateTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour = 0, uint8_t minute = 0, uint8_t second = 0);
+
+    inline uint16_t year() const {
+        return yOff + 2000;
+    }
+
+    inline uint8_t month() const {
+        return m;
+    }
+
+    inline uint8_t day() const {
+        return d;
+    }
+
+    inline uint8_t hour() const {
+        return hh;
+    }
+
+    inline uint8_t minute() const {
+        return mm;
+    }
+
+    inline uint8_t second() const {
+        return ss;
+    }
+
+    uint32_t unixtime() const;
+private:
+    uint8_t yOff = 0, m = 1, d = 1, hh = 0, mm = 0, ss = 0;
+};
+
+class RTClib {
+public:
+    static DateTime now();
+};
+
+class DS3231 {
+public:
+    float getTemperature();
+    void setEpoch(time_t epoch = 0, bool flag_localtime = false);
+
+    void setA1Time(uint8_t day, uint8_t hour, uint8_t minute, uint8_t second, uint8_t alarmBits, bool dayOfWeek, bool h12, bool pm);
+    void turnOnAlarm(uint8_t alarm);
+    void turnOffAlarm(uint8_t alarm);
+    bool checkIfAlarm(uint8_t alarm, bool clearFlag = true);
+
+    static time_t offset; // Seconds added to the host clock by setEpoch()
+private:
+    time_t alarmAt = 0;
+    bool alarmEnabled = false;
+};
+
+#endif //RP2040_LORA_APRS_NATIVE_DS3231_H
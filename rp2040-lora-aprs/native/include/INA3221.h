@@ -0,0 +1,46 @@
+#ifndef RP2040_LORA_APRS_NATIVE_INA3221_H
+#define RP2040_LORA_APRS_NATIVE_INA3221_H
+
+#include <Wire.h>
+
+// Host replacement: no sensor on the bus, the die ID never matches
+
+typedef enum {
+    INA3221_ADDR40_GND = 0b1000000,
+    INA3221_ADDR41_VCC = 0b1000001,
+    INA3221_ADDR42_SDA = 0b1000010,
+    INA3221_ADDR43_SCL = 0b1000011
+} ina3221_addr_t;
+
+typedef enum {
+    INA3221_CH1 = 0,
+    INA3221_CH2,
+    INA3221_CH3,
+    INA3221_CH_NUM
+} ina3221_ch_t;
+
+class INA3221 {
+public:
+    explicit INA3221(const ina3221_addr_t address) {
+    }
+
+    inline void begin(TwoWire *wire = &Wire) {
+    }
+
+    inline void setShuntRes(uint32_t, uint32_t, uint32_t) {
+    }
+
+    inline uint16_t getDieID() {
+        return 0;
+    }
+
+    inline float getVoltage(ina3221_ch_t) {
+        return 0;
+    }
+
+    inline float getCurrent(ina3221_ch_t) {
+        return 0;
+    }
+};
+
+#endif //RP2040_LORA_APRS_NATIVE_INA3221_H
@@ -0,0 +1,66 @@
+#ifndef RP2040_LORA_APRS_NATIVE_LITTLEFS_H
+#define RP2040_LORA_APRS_NATIVE_LITTLEFS_H
+
+#include <Arduino.h>
+
+enum SeekMode {
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+// File of the host directory used as flash (LITTLEFS_ROOT, default ".littlefs")
+class File : public Stream {
+public:
+    File() = default;
+    explicit File(FILE *file);
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *data, size_t size) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int peek() override;
+    void flush() override;
+
+    size_t read(uint8_t *data, size_t size);
+    bool seek(uint32_t position, SeekMode mode = SeekSet);
+    size_t position() const;
+    size_t size() const;
+    void close();
+
+    explicit operator bool() const {
+        return file != nullptr;
+    }
+private:
+    FILE *file = nullptr;
+};
+
+typedef struct {
+    uint32_t opens;
+    uint32_t writes;
+    uint32_t bytesWritten;
+    uint32_t formats;
+} FSStats;
+
+class FS {
+public:
+    bool begin();
+    void end();
+    bool format();
+
+    File open(const char *path, const char *mode);
+    bool exists(const char *path);
+    bool remove(const char *path);
+    bool rename(const char *pathFrom, const char *pathTo);
+
+    FSStats stats{}; // Host only: flash usage counters, to measure writes per received packet
+private:
+    char root[256]{};
+
+    void resolve(const char *path, char *result, size_t size) const;
+};
+
+extern FS LittleFS;
+
+#endif //RP2040_LORA_APRS_NATIVE_LITTLEFS_H
@@ -0,0 +1,19 @@
+#ifndef RP2040_LORA_APRS_PICOSLEEP_H
+#define RP2040_LORA_APRS_PICOSLEEP_H
+
+#include <ctime>
+#include "hardware/rtc.h"
+
+// Host replacement of lib/PicoSleep (ignored by env:native)
+
+void epoch_to_datetime(time_t epoch, datetime_t *dt);
+
+void cpuDeepSleep(uint32_t msecs);
+
+// Light sleep: while both cores wait for an event, only the clocks needed to wake them up keep running.
+// Nothing to restore, the clocks come back as soon as a core wakes up.
+void lightSleepGateClocks(bool keepUsb);
+// The deep sleep bit is per core, so each core enables it for itself
+void lightSleepEnableCore();
+
+#endif //RP2040_LORA_APRS_PICOSLEEP_H
@@ -0,0 +1,67 @@
+#ifndef RP2040_LORA_APRS_NATIVE_PRINT_H
+#define RP2040_LORA_APRS_NATIVE_PRINT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include "WString.h"
+#include "Printable.h"
+
+class Print {
+public:
+    virtual ~Print() = default;
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+
+    virtual int availableForWrite() {
+        return 0;
+    }
+
+    virtual void flush() {
+    }
+
+    inline size_t write(const char *str) {
+        return str == nullptr ? 0 : write(reinterpret_cast<const uint8_t *>(str), strlen(str));
+    }
+
+    inline size_t write(const char *buffer, const size_t size) {
+        return write(reinterpret_cast<const uint8_t *>(buffer), size);
+    }
+
+    size_t print(const __FlashStringHelper *value);
+    size_t print(const String &value);
+    size_t print(const char value[]);
+    size_t print(char value);
+    size_t print(unsigned char value, int base = 10);
+    size_t print(int value, int base = 10);
+    size_t print(unsigned int value, int base = 10);
+    size_t print(long value, int base = 10);
+    size_t print(unsigned long value, int base = 10);
+    size_t print(long long value, int base = 10);
+    size_t print(unsigned long long value, int base = 10);
+    size_t print(double value, int digits = 2);
+    size_t print(const Printable &value);
+
+    size_t println(const __FlashStringHelper *value);
+    size_t println(const String &value);
+    size_t println(const char value[]);
+    size_t println(char value);
+    size_t println(unsigned char value, int base = 10);
+    size_t println(int value, int base = 10);
+    size_t println(unsigned int value, int base = 10);
+    size_t println(long value, int base = 10);
+    size_t println(unsigned long value, int base = 10);
+    size_t println(long long value, int base = 10);
+    size_t println(unsigned long long value, int base = 10);
+    size_t println(double value, int digits = 2);
+    size_t println(const Printable &value);
+    size_t println();
+
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+private:
+    size_t printNumber(unsigned long long value, int base);
+};
+
+#endif //RP2040_LORA_APRS_NATIVE_PRINT_H
@@ -0,0 +1,14 @@
+#ifndef RP2040_LORA_APRS_NATIVE_PRINTABLE_H
+#define RP2040_LORA_APRS_NATIVE_PRINTABLE_H
+
+#include <cstddef>
+
+class Print;
+
+class Printable {
+public:
+    virtual ~Printable() = default;
+    virtual size_t printTo(Print &p) const = 0;
+};
+
+#endif //RP2040_LORA_APRS_NATIVE_PRINTABLE_H
@@ -0,0 +1,171 @@
+#ifndef RP2040_LORA_APRS_NATIVE_RADIOLIB_H
+#define RP2040_LORA_APRS_NATIVE_RADIOLIB_H
+
+#include <Arduino.h>
+#include <SPI.h>
+
+/*
+ * Host replacement of RadioLib: the SX1262 is an in-process radio model.
+ * Frames are injected on the "air" with RadioModel::inject() and delivered through the DIO1 action
+ * exactly as the real chip does, so Communication::update() runs the same code path as on the board.
+ */
+
+#define RADIOLIB_NC (0xFFFFFFFF)
+
+#define RADIOLIB_ERR_NONE (0)
+#define RADIOLIB_ERR_UNKNOWN (-1)
+#define RADIOLIB_ERR_CHIP_NOT_FOUND (-2)
+#define RADIOLIB_ERR_PACKET_TOO_LONG (-4)
+#define RADIOLIB_ERR_TX_TIMEOUT (-5)
+#define RADIOLIB_ERR_RX_TIMEOUT (-6)
+#define RADIOLIB_ERR_CRC_MISMATCH (-7)
+#define RADIOLIB_ERR_INVALID_BANDWIDTH (-8)
+#define RADIOLIB_ERR_INVALID_SPREADING_FACTOR (-9)
+#define RADIOLIB_ERR_INVALID_CODING_RATE (-10)
+#define RADIOLIB_ERR_INVALID_FREQUENCY (-12)
+#define RADIOLIB_ERR_INVALID_OUTPUT_POWER (-13)
+#define RADIOLIB_PREAMBLE_DETECTED (-14)
+#define RADIOLIB_CHANNEL_FREE (-15)
+#define RADIOLIB_LORA_DETECTED (-701)
+
+#define RADIOLIB_SX126X_SYNC_WORD_PUBLIC 0x34
+#define RADIOLIB_SX126X_SYNC_WORD_PRIVATE 0x12
+#define RADIOLIB_SX126X_LORA_CRC_OFF 0x00
+#define RADIOLIB_SX126X_LORA_CRC_ON 0x01
+#define RADIOLIB_SX126X_MAX_PACKET_LENGTH 255
+
+#define RADIOLIB_SX126X_IRQ_TIMEOUT 0b1000000000
+#define RADIOLIB_SX126X_IRQ_CAD_DETECTED 0b0100000000
+#define RADIOLIB_SX126X_IRQ_CAD_DONE 0b0010000000
+#define RADIOLIB_SX126X_IRQ_CRC_ERR 0b0001000000
+#define RADIOLIB_SX126X_IRQ_HEADER_ERR 0b0000100000
+#define RADIOLIB_SX126X_IRQ_HEADER_VALID 0b0000010000
+#define RADIOLIB_SX126X_IRQ_SYNC_WORD_VALID 0b0000001000
+#define RADIOLIB_SX126X_IRQ_PREAMBLE_DETECTED 0b0000000100
+#define RADIOLIB_SX126X_IRQ_RX_DONE 0b0000000010
+#define RADIOLIB_SX126X_IRQ_TX_DONE 0b0000000001
+#define RADIOLIB_SX126X_IRQ_NONE 0b0000000000
+
+#define RADIOLIB_IRQ_TX_DONE RADIOLIB_SX126X_IRQ_TX_DONE
+#define RADIOLIB_IRQ_RX_DONE RADIOLIB_SX126X_IRQ_RX_DONE
+#define RADIOLIB_IRQ_PREAMBLE_DETECTED RADIOLIB_SX126X_IRQ_PREAMBLE_DETECTED
+#define RADIOLIB_IRQ_HEADER_VALID RADIOLIB_SX126X_IRQ_HEADER_VALID
+#define RADIOLIB_IRQ_HEADER_ERR RADIOLIB_SX126X_IRQ_HEADER_ERR
+#define RADIOLIB_IRQ_CRC_ERR RADIOLIB_SX126X_IRQ_CRC_ERR
+#define RADIOLIB_IRQ_CAD_DONE RADIOLIB_SX126X_IRQ_CAD_DONE
+#define RADIOLIB_IRQ_CAD_DETECTED RADIOLIB_SX126X_IRQ_CAD_DETECTED
+#define RADIOLIB_IRQ_TIMEOUT RADIOLIB_SX126X_IRQ_TIMEOUT
+#define RADIOLIB_IRQ_RX_DEFAULT_FLAGS (RADIOLIB_IRQ_RX_DONE | RADIOLIB_IRQ_TIMEOUT | RADIOLIB_IRQ_CRC_ERR | RADIOLIB_IRQ_HEADER_VALID | RADIOLIB_IRQ_HEADER_ERR)
+
+typedef uint32_t RadioLibIrqFlags_t;
+typedef uint32_t RadioLibTime_t;
+
+class Module {
+public:
+    Module(const uint32_t cs, const uint32_t irq, const uint32_t rst, const uint32_t gpio, SPIClassRP2040 &spi, const SPISettings &spiSettings) : spiSettings(spiSettings) {
+    }
+
+    SPISettings spiSettings;
+};
+
+enum RadioModelMode {
+    RadioModelStandby,
+    RadioModelReceive,
+    RadioModelTransmit,
+    RadioModelChannelScan
+};
+
+class SX1262 {
+public:
+    SX1262(Module *module); // NOLINT(*-explicit-constructor)
+
+    int16_t begin(float frequency = 434.0, float bandwidth = 125.0, uint8_t spreadingFactor = 9, uint8_t codingRate = 7, uint8_t syncWord = RADIOLIB_SX126X_SYNC_WORD_PRIVATE, int8_t outputPower = 10, uint16_t preambleLength = 8, float tcxoVoltage = 1.6, bool useRegulatorLDO = false);
+
+    void setDio1Action(void (*function)());
+    void clearDio1Action();
+    int16_t setDio2AsRfSwitch(bool enable = true);
+    void setRfSwitchPins(uint32_t rxEn, uint32_t txEn);
+    int16_t setRxBoostedGainMode(bool rxbgm, bool persist = true);
+    int16_t setCRC(uint8_t len, uint16_t initial = 0x1D0F, uint16_t polynomial = 0x1021, bool inverted = true);
+    int16_t setCurrentLimit(float currentLimit);
+
+    int16_t setFrequency(float frequency);
+    int16_t setBandwidth(float bandwidth);
+    int16_t setSpreadingFactor(uint8_t spreadingFactor);
+    int16_t setCodingRate(uint8_t codingRate);
+    int16_t setOutputPower(int8_t power);
+    int16_t setPreambleLength(size_t preambleLength);
+
+    int16_t standby();
+    int16_t sleep(bool retainConfig = true);
+
+    int16_t transmit(const uint8_t *data, size_t len, uint8_t addr = 0);
+    int16_t startTransmit(const uint8_t *data, size_t len, uint8_t addr = 0);
+    int16_t finishTransmit();
+
+    int16_t startReceive();
+    int16_t startReceiveDutyCycleAuto(uint16_t senderPreambleLength = 0, uint16_t minSymbols = 8, RadioLibIrqFlags_t irqFlags = RADIOLIB_IRQ_RX_DEFAULT_FLAGS, uint32_t irqMask = RADIOLIB_IRQ_RX_DEFAULT_FLAGS);
+    size_t getPacketLength(bool update = true);
+    int16_t readData(uint8_t *data, size_t len);
+    float getRSSI();
+    float getSNR();
+
+    int16_t scanChannel();
+    int16_t startChannelScan();
+    int16_t getChannelScanResult();
+
+    uint32_t getIrqFlags();
+    int16_t clearIrqFlags(uint32_t flags);
+    RadioLibTime_t getTimeOnAir(size_t len);
+private:
+    friend class RadioModel;
+
+    float frequency = 434.0;
+    float bandwidth = 125.0;
+    uint8_t spreadingFactor = 9;
+    uint8_t codingRate = 7;
+    int8_t outputPower = 10;
+    uint16_t preambleLength = 8;
+
+    RadioModelMode mode = RadioModelStandby;
+    uint32_t irqFlags = 0;
+    void (*dio1Action)() = nullptr;
+
+    uint8_t rxData[RADIOLIB_SX126X_MAX_PACKET_LENGTH]{};
+    size_t rxLength = 0;
+    float rxRssi = 0;
+    float rxSnr = 0;
+
+    unsigned long operationEnd = 0;
+
+    void raise(uint32_t flags);
+};
+
+typedef struct {
+    uint32_t framesInjected;
+    uint32_t framesDelivered;
+    uint32_t framesMissed;
+    uint32_t framesTransmitted;
+    uint64_t airtimeTransmitted;
+} RadioModelStats;
+
+class RadioModel {
+public:
+    // Put a frame on the air, fully received at the given millis()
+    static bool inject(const uint8_t *data, size_t size, float rssi = -90, float snr = 8, unsigned long at = 0);
+    // Advance the model: finish pending TX/CAD and deliver due frames through DIO1
+    static void poll();
+
+    // Microseconds, codingRate from 5 to 8 for 4/5 to 4/8
+    static RadioLibTime_t timeOnAir(size_t size, float bandwidth, uint8_t spreadingFactor, uint8_t codingRate, uint16_t preambleLength);
+    static bool isChannelBusy();
+
+    static void (*onTransmit)(const uint8_t *data, size_t size, RadioLibTime_t timeOnAir);
+    static RadioModelStats stats;
+private:
+    friend class SX1262;
+
+    static SX1262 *radio;
+};
+
+#endif //RP2040_LORA_APRS_NATIVE_RADIOLIB_H
@@ -0,0 +1,48 @@
+#ifndef RP2040_LORA_APRS_NATIVE_SPI_H
+#define RP2040_LORA_APRS_NATIVE_SPI_H
+
+#include <Arduino.h>
+
+#define MSBFIRST 1
+#define LSBFIRST 0
+
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+#define SPI_MODE2 2
+#define SPI_MODE3 3
+
+class SPISettings {
+public:
+    SPISettings(const uint32_t clock, const uint8_t bitOrder, const uint8_t dataMode) : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {
+    }
+
+    uint32_t clock;
+    uint8_t bitOrder;
+    uint8_t dataMode;
+};
+
+class SPIClassRP2040 {
+public:
+    inline bool setSCK(pin_size_t) {
+        return true;
+    }
+
+    inline bool setTX(pin_size_t) {
+        return true;
+    }
+
+    inline bool setRX(pin_size_t) {
+        return true;
+    }
+
+    inline void begin(bool hwCs = false) {
+    }
+
+    inline void end() {
+    }
+};
+
+extern SPIClassRP2040 SPI;
+extern SPIClassRP2040 SPI1;
+
+#endif //RP2040_LORA_APRS_NATIVE_SPI_H
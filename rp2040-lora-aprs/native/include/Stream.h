@@ -0,0 +1,27 @@
+#ifndef RP2040_LORA_APRS_NATIVE_STREAM_H
+#define RP2040_LORA_APRS_NATIVE_STREAM_H
+
+#include "Print.h"
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    inline void setTimeout(const unsigned long timeout) {
+        this->timeout = timeout;
+    }
+
+    size_t readBytes(char *buffer, size_t length);
+    size_t readBytes(uint8_t *buffer, size_t length);
+    size_t readBytesUntil(char terminator, char *buffer, size_t length);
+    size_t readBytesUntil(char terminator, uint8_t *buffer, size_t length);
+    String readStringUntil(char terminator);
+protected:
+    unsigned long timeout = 1000;
+
+    int timedRead();
+};
+
+#endif //RP2040_LORA_APRS_NATIVE_STREAM_H
@@ -0,0 +1,98 @@
+#ifndef RP2040_LORA_APRS_NATIVE_WSTRING_H
+#define RP2040_LORA_APRS_NATIVE_WSTRING_H
+
+#include <string>
+#include <cstdint>
+
+#include "pgmspace.h"
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(PSTR(string_literal)))
+#define FPSTR(pstr_pointer) (reinterpret_cast<const __FlashStringHelper *>(pstr_pointer))
+
+// Arduino String over std::string, enough for ArduinoThread names and ArduinoLog
+class String {
+public:
+    String() = default;
+    String(const char *value) : value(value != nullptr ? value : "") {} // NOLINT(*-explicit-constructor)
+    String(const __FlashStringHelper *value) : String(reinterpret_cast<const char *>(value)) {} // NOLINT(*-explicit-constructor)
+    explicit String(char c) : value(1, c) {}
+    explicit String(int number, unsigned char base = 10);
+    explicit String(unsigned int number, unsigned char base = 10);
+    explicit String(long number, unsigned char base = 10);
+    explicit String(unsigned long number, unsigned char base = 10);
+    explicit String(double number, unsigned char decimalPlaces = 2);
+
+    inline const char *c_str() const {
+        return value.c_str();
+    }
+
+    inline unsigned int length() const {
+        return value.length();
+    }
+
+    inline bool reserve(const unsigned int size) {
+        value.reserve(size);
+        return true;
+    }
+
+    inline bool concat(const String &other) {
+        value += other.value;
+        return true;
+    }
+
+    inline bool concat(const char *other) {
+        value += other;
+        return true;
+    }
+
+    inline bool concat(const char c) {
+        value += c;
+        return true;
+    }
+
+    inline bool concat(const int number) {
+        return concat(String(number));
+    }
+
+    inline bool concat(const unsigned int number) {
+        return concat(String(number));
+    }
+
+    inline bool concat(const long number) {
+        return concat(String(number));
+    }
+
+    inline bool concat(const unsigned long number) {
+        return concat(String(number));
+    }
+
+    template<typename T>
+    inline String &operator+=(const T &other) {
+        concat(other);
+        return *this;
+    }
+
+    inline bool operator==(const String &other) const {
+        return value == other.value;
+    }
+
+    inline bool operator==(const char *other) const {
+        return value == other;
+    }
+
+    inline char operator[](const unsigned int index) const {
+        return value[index];
+    }
+
+    template<typename T>
+    friend inline String operator+(const String &left, const T &right) {
+        String result = left;
+        result.concat(right);
+        return result;
+    }
+private:
+    std::string value;
+};
+
+#endif //RP2040_LORA_APRS_NATIVE_WSTRING_H
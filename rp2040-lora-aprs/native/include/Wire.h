@@ -0,0 +1,43 @@
+#ifndef RP2040_LORA_APRS_NATIVE_WIRE_H
+#define RP2040_LORA_APRS_NATIVE_WIRE_H
+
+#include <Arduino.h>
+
+// I2C bus with no device on it: every transmission is NACKed so sensors report errors like an empty bus
+class TwoWire : public Stream {
+public:
+    inline bool setSDA(pin_size_t) {
+        return true;
+    }
+
+    inline bool setSCL(pin_size_t) {
+        return true;
+    }
+
+    void begin();
+    void begin(uint8_t address);
+    void end();
+    void setClock(uint32_t frequency);
+
+    void beginTransmission(uint8_t address);
+    uint8_t endTransmission(bool stopBit = true);
+    size_t requestFrom(uint8_t address, size_t quantity, bool stopBit = true);
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *data, size_t size) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int peek() override;
+
+    void onReceive(void (*callback)(int));
+    void onRequest(void (*callback)());
+private:
+    void (*receiveCallback)(int) = nullptr;
+    void (*requestCallback)() = nullptr;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif //RP2040_LORA_APRS_NATIVE_WIRE_H
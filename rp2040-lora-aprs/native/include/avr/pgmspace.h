@@ -0,0 +1,6 @@
+#ifndef RP2040_LORA_APRS_NATIVE_AVR_PGMSPACE_H
+#define RP2040_LORA_APRS_NATIVE_AVR_PGMSPACE_H
+
+#include "../pgmspace.h"
+
+#endif //RP2040_LORA_APRS_NATIVE_AVR_PGMSPACE_H
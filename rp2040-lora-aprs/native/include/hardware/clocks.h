@@ -0,0 +1,31 @@
+#ifndef RP2040_LORA_APRS_NATIVE_HARDWARE_CLOCKS_H
+#define RP2040_LORA_APRS_NATIVE_HARDWARE_CLOCKS_H
+
+#include <cstdint>
+
+#define KHZ 1000
+#define MHZ 1000000
+
+#define CLOCKS_CLK_PERI_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS 0x1
+#define CLOCKS_CLK_ADC_CTRL_AUXSRC_VALUE_CLKSRC_PLL_SYS 0x1
+#define CLOCKS_CLK_RTC_CTRL_AUXSRC_VALUE_XOSC_CLKSRC 0x3
+
+enum clock_index {
+    clk_gpout0 = 0,
+    clk_gpout1,
+    clk_gpout2,
+    clk_gpout3,
+    clk_ref,
+    clk_sys,
+    clk_peri,
+    clk_usb,
+    clk_adc,
+    clk_rtc,
+    CLK_COUNT
+};
+
+bool set_sys_clock_khz(uint32_t freqKhz, bool required);
+bool clock_configure(clock_index clockIndex, uint32_t src, uint32_t auxsrc, uint32_t srcFreq, uint32_t freq);
+uint32_t clock_get_hz(clock_index clockIndex);
+
+#endif //RP2040_LORA_APRS_NATIVE_HARDWARE_CLOCKS_H
@@ -0,0 +1,11 @@
+#ifndef RP2040_LORA_APRS_NATIVE_HARDWARE_PLL_H
+#define RP2040_LORA_APRS_NATIVE_HARDWARE_PLL_H
+
+typedef struct pll_hw pll_hw_t;
+
+extern pll_hw_t *pll_sys;
+extern pll_hw_t *pll_usb;
+
+void pll_deinit(pll_hw_t *pll);
+
+#endif //RP2040_LORA_APRS_NATIVE_HARDWARE_PLL_H
@@ -0,0 +1,23 @@
+#ifndef RP2040_LORA_APRS_NATIVE_HARDWARE_RTC_H
+#define RP2040_LORA_APRS_NATIVE_HARDWARE_RTC_H
+
+#include <cstdint>
+
+typedef struct {
+    int16_t year;
+    int8_t month;
+    int8_t day;
+    int8_t dotw;
+    int8_t hour;
+    int8_t min;
+    int8_t sec;
+} datetime_t;
+
+typedef void (*rtc_callback_t)();
+
+void rtc_init();
+bool rtc_set_datetime(datetime_t *t);
+bool rtc_get_datetime(datetime_t *t);
+bool rtc_running();
+
+#endif //RP2040_LORA_APRS_NATIVE_HARDWARE_RTC_H
@@ -0,0 +1,8 @@
+#ifndef RP2040_LORA_APRS_NATIVE_HARDWARE_SYNC_H
+#define RP2040_LORA_APRS_NATIVE_HARDWARE_SYNC_H
+
+// One thread on host, the other core runs when this one waits
+inline void __sev() {
+}
+
+#endif //RP2040_LORA_APRS_NATIVE_HARDWARE_SYNC_H
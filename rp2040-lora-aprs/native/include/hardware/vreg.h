@@ -0,0 +1,16 @@
+#ifndef RP2040_LORA_APRS_NATIVE_HARDWARE_VREG_H
+#define RP2040_LORA_APRS_NATIVE_HARDWARE_VREG_H
+
+enum vreg_voltage {
+    VREG_VOLTAGE_0_85 = 0b0110,
+    VREG_VOLTAGE_0_90 = 0b0111,
+    VREG_VOLTAGE_0_95 = 0b1000,
+    VREG_VOLTAGE_1_00 = 0b1001,
+    VREG_VOLTAGE_1_05 = 0b1010,
+    VREG_VOLTAGE_1_10 = 0b1011,
+    VREG_VOLTAGE_DEFAULT = VREG_VOLTAGE_1_10,
+};
+
+void vreg_set_voltage(vreg_voltage voltage);
+
+#endif //RP2040_LORA_APRS_NATIVE_HARDWARE_VREG_H
@@ -0,0 +1,6 @@
+#ifndef RP2040_LORA_APRS_NATIVE_HARDWARE_WATCHDOG_H
+#define RP2040_LORA_APRS_NATIVE_HARDWARE_WATCHDOG_H
+
+bool watchdog_caused_reboot();
+
+#endif //RP2040_LORA_APRS_NATIVE_HARDWARE_WATCHDOG_H
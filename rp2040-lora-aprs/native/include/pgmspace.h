@@ -0,0 +1,34 @@
+#ifndef RP2040_LORA_APRS_NATIVE_PGMSPACE_H
+#define RP2040_LORA_APRS_NATIVE_PGMSPACE_H
+
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+
+// On host there is no flash address space: every _P helper is the RAM one
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t *>(addr))
+#define pgm_read_word(addr) (*reinterpret_cast<const uint16_t *>(addr))
+#define pgm_read_dword(addr) (*reinterpret_cast<const uint32_t *>(addr))
+#define pgm_read_ptr(addr) (*reinterpret_cast<void * const *>(addr))
+
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define strcasecmp_P strcasecmp
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strcat_P strcat
+#define strncat_P strncat
+#define strstr_P strstr
+#define memcpy_P memcpy
+#define sprintf_P sprintf
+#define snprintf_P snprintf
+#define vsnprintf_P vsnprintf
+#define printf_P printf
+
+#endif //RP2040_LORA_APRS_NATIVE_PGMSPACE_H
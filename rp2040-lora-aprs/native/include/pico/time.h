@@ -0,0 +1,14 @@
+#ifndef RP2040_LORA_APRS_NATIVE_PICO_TIME_H
+#define RP2040_LORA_APRS_NATIVE_PICO_TIME_H
+
+#include <cstdint>
+
+typedef uint64_t absolute_time_t; // Microseconds since boot
+
+absolute_time_t get_absolute_time();
+absolute_time_t make_timeout_time_ms(uint32_t milliseconds);
+// No event on host: sleeps at most 1ms with the radio model and the second core running, true when the timeout is reached.
+// On the second core, returns at once to give the hand back to the first one.
+bool best_effort_wfe_or_timeout(absolute_time_t timeout);
+
+#endif //RP2040_LORA_APRS_NATIVE_PICO_TIME_H
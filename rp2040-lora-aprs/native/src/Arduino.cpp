@@ -0,0 +1,643 @@
+#include <Arduino.h>
+#include <RadioLib.h>
+#include <LittleFS.h>
+#include <pico/time.h>
+#include "Ax25.h"
+
+#include <chrono>
+#include <csignal>
+#include <cstdarg>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+RP2040 rp2040;
+
+SerialPort Serial("USB");
+SerialPort Serial1("UART0");
+SerialPort Serial2("UART1");
+
+static const auto startTime = std::chrono::steady_clock::now();
+
+// One thread on host: the second core does a loop each time the first one waits, and gives the hand back at its own wait
+static bool isCore1Started = false;
+static bool isOnCore1 = false;
+
+static void runCore1() {
+    if (!isCore1Started || isOnCore1) {
+        return;
+    }
+
+    isOnCore1 = true;
+    loop1();
+    isOnCore1 = false;
+}
+
+unsigned long millis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+unsigned long micros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void delay(const unsigned long milliseconds) {
+    const unsigned long end = millis() + milliseconds;
+
+    // Keep the radio model alive while the firmware blocks, like the SX1262 does on the board
+    while (millis() < end) {
+        RadioModel::poll();
+        runCore1();
+        std::this_thread::sleep_for(std::chrono::milliseconds(std::min(end - millis(), 1UL)));
+    }
+}
+
+absolute_time_t get_absolute_time() {
+    return micros();
+}
+
+absolute_time_t make_timeout_time_ms(const uint32_t milliseconds) {
+    return get_absolute_time() + static_cast<absolute_time_t>(milliseconds) * 1000;
+}
+
+bool best_effort_wfe_or_timeout(const absolute_time_t timeout) {
+    RadioModel::poll();
+
+    if (isOnCore1) {
+        return true;
+    }
+
+    runCore1();
+
+    if (get_absolute_time() >= timeout) {
+        return true;
+    }
+
+    std::this_thread::sleep_for(std::chrono::microseconds(std::min<absolute_time_t>(timeout - get_absolute_time(), 1000)));
+
+    return get_absolute_time() >= timeout;
+}
+
+void delayMicroseconds(const unsigned int microseconds) {
+    std::this_thread::sleep_for(std::chrono::microseconds(microseconds));
+}
+
+void yield() {
+    RadioModel::poll();
+}
+
+void pinMode(pin_size_t pin, PinMode mode) {
+}
+
+void digitalWrite(pin_size_t pin, int value) {
+}
+
+PinStatus digitalRead(pin_size_t pin) {
+    return LOW;
+}
+
+int analogRead(pin_size_t pin) {
+    return 0;
+}
+
+void attachInterrupt(pin_size_t pin, void (*callback)(), PinStatus mode) {
+}
+
+void detachInterrupt(pin_size_t pin) {
+}
+
+long random(const long max) {
+    return max > 0 ? rand() % max : 0; // NOLINT(*-msc50-cpp)
+}
+
+long random(const long min, const long max) {
+    return min >= max ? min : min + random(max - min);
+}
+
+bool watchdog_caused_reboot() {
+    return false;
+}
+
+bool set_sys_clock_khz(uint32_t freqKhz, bool required) {
+    return true;
+}
+
+bool clock_configure(clock_index clockIndex, uint32_t src, uint32_t auxsrc, uint32_t srcFreq, uint32_t freq) {
+    return true;
+}
+
+uint32_t clock_get_hz(clock_index clockIndex) {
+    return 125 * MHZ;
+}
+
+void RP2040::wdt_begin(uint32_t delayMs) {
+}
+
+void RP2040::wdt_reset() {
+}
+
+void RP2040::reboot() {
+    fprintf(stderr, "[NATIVE] Reboot requested, exit\n");
+    exit(0);
+}
+
+void RP2040::rebootToBootloader() {
+    fprintf(stderr, "[NATIVE] DFU requested, exit\n");
+    exit(0);
+}
+
+// Print
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t written = 0;
+
+    while (size--) {
+        written += write(*buffer++);
+    }
+
+    return written;
+}
+
+size_t Print::printNumber(unsigned long long value, const int base) {
+    char text[8 * sizeof(value) + 1];
+    char *str = &text[sizeof(text) - 1];
+    *str = '\0';
+
+    const int radix = base < 2 ? 10 : base;
+
+    do {
+        const char digit = static_cast<char>(value % radix);
+        value /= radix;
+        *--str = static_cast<char>(digit < 10 ? digit + '0' : digit + 'A' - 10);
+    } while (value);
+
+    return write(str);
+}
+
+size_t Print::print(const __FlashStringHelper *value) {
+    return write(reinterpret_cast<const char *>(value));
+}
+
+size_t Print::print(const String &value) {
+    return write(value.c_str(), value.length());
+}
+
+size_t Print::print(const char value[]) {
+    return write(value);
+}
+
+size_t Print::print(const char value) {
+    return write(static_cast<uint8_t>(value));
+}
+
+size_t Print::print(const unsigned char value, const int base) {
+    return print(static_cast<unsigned long long>(value), base);
+}
+
+size_t Print::print(const int value, const int base) {
+    return print(static_cast<long long>(value), base);
+}
+
+size_t Print::print(const unsigned int value, const int base) {
+    return print(static_cast<unsigned long long>(value), base);
+}
+
+size_t Print::print(const long value, const int base) {
+    return print(static_cast<long long>(value), base);
+}
+
+size_t Print::print(const unsigned long value, const int base) {
+    return print(static_cast<unsigned long long>(value), base);
+}
+
+size_t Print::print(const long long value, const int base) {
+    if (base == 10 && value < 0) {
+        return print('-') + printNumber(-static_cast<unsigned long long>(value), base);
+    }
+
+    return printNumber(value, base);
+}
+
+size_t Print::print(const unsigned long long value, const int base) {
+    return printNumber(value, base);
+}
+
+size_t Print::print(const double value, const int digits) {
+    char text[64];
+    snprintf(text, sizeof(text), "%.*f", digits, value);
+    return write(text);
+}
+
+size_t Print::print(const Printable &value) {
+    return value.printTo(*this);
+}
+
+size_t Print::println() {
+    return write("\r\n");
+}
+
+size_t Print::println(const __FlashStringHelper *value) {
+    return print(value) + println();
+}
+
+size_t Print::println(const String &value) {
+    return print(value) + println();
+}
+
+size_t Print::println(const char value[]) {
+    return print(value) + println();
+}
+
+size_t Print::println(const char value) {
+    return print(value) + println();
+}
+
+size_t Print::println(const unsigned char value, const int base) {
+    return print(value, base) + println();
+}
+
+size_t Print::println(const int value, const int base) {
+    return print(value, base) + println();
+}
+
+size_t Print::println(const unsigned int value, const int base) {
+    return print(value, base) + println();
+}
+
+size_t Print::println(const long value, const int base) {
+    return print(value, base) + println();
+}
+
+size_t Print::println(const unsigned long value, const int base) {
+    return print(value, base) + println();
+}
+
+size_t Print::println(const long long value, const int base) {
+    return print(value, base) + println();
+}
+
+size_t Print::println(const unsigned long long value, const int base) {
+    return print(value, base) + println();
+}
+
+size_t Print::println(const double value, const int digits) {
+    return print(value, digits) + println();
+}
+
+size_t Print::println(const Printable &value) {
+    return print(value) + println();
+}
+
+size_t Print::printf(const char *format, ...) {
+    char text[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    return write(text);
+}
+
+// Stream
+
+int Stream::timedRead() {
+    const unsigned long start = millis();
+
+    do {
+        const int c = read();
+        if (c >= 0) {
+            return c;
+        }
+        yield();
+    } while (millis() - start < timeout);
+
+    return -1;
+}
+
+size_t Stream::readBytes(char *buffer, const size_t length) {
+    size_t count = 0;
+
+    while (count < length) {
+        const int c = timedRead();
+        if (c < 0) {
+            break;
+        }
+        *buffer++ = static_cast<char>(c);
+        count++;
+    }
+
+    return count;
+}
+
+size_t Stream::readBytes(uint8_t *buffer, const size_t length) {
+    return readBytes(reinterpret_cast<char *>(buffer), length);
+}
+
+size_t Stream::readBytesUntil(const char terminator, char *buffer, const size_t length) {
+    size_t index = 0;
+
+    while (index < length) {
+        const int c = timedRead();
+        if (c < 0 || c == terminator) {
+            break;
+        }
+        *buffer++ = static_cast<char>(c);
+        index++;
+    }
+
+    return index;
+}
+
+size_t Stream::readBytesUntil(const char terminator, uint8_t *buffer, const size_t length) {
+    return readBytesUntil(terminator, reinterpret_cast<char *>(buffer), length);
+}
+
+String Stream::readStringUntil(const char terminator) {
+    String result;
+    int c = timedRead();
+
+    while (c >= 0 && c != terminator) {
+        result.concat(static_cast<char>(c));
+        c = timedRead();
+    }
+
+    return result;
+}
+
+// String
+
+String::String(const int number, const unsigned char base) : String(static_cast<long>(number), base) {
+}
+
+String::String(const unsigned int number, const unsigned char base) : String(static_cast<unsigned long>(number), base) {
+}
+
+String::String(const long number, const unsigned char base) {
+    char text[8 * sizeof(number) + 2];
+
+    if (base == 10) {
+        snprintf(text, sizeof(text), "%ld", number);
+    } else if (base == 16) {
+        snprintf(text, sizeof(text), "%lx", number);
+    } else {
+        snprintf(text, sizeof(text), "%lo", number);
+    }
+
+    value = text;
+}
+
+String::String(const unsigned long number, const unsigned char base) {
+    char text[8 * sizeof(number) + 2];
+
+    if (base == 10) {
+        snprintf(text, sizeof(text), "%lu", number);
+    } else if (base == 16) {
+        snprintf(text, sizeof(text), "%lx", number);
+    } else {
+        snprintf(text, sizeof(text), "%lo", number);
+    }
+
+    value = text;
+}
+
+String::String(const double number, const unsigned char decimalPlaces) {
+    char text[64];
+    snprintf(text, sizeof(text), "%.*f", decimalPlaces, number);
+    value = text;
+}
+
+// SerialPort
+
+SerialPort::SerialPort(const char *name) : name(name) {
+}
+
+void SerialPort::begin(unsigned long baud) {
+}
+
+void SerialPort::end() {
+}
+
+bool SerialPort::setFIFOSize(size_t size) {
+    return true;
+}
+
+bool SerialPort::overflow() {
+    return false;
+}
+
+void SerialPort::bind(const int inputFd, const int outputFd) {
+    this->inputFd = inputFd;
+    this->outputFd = outputFd;
+
+    if (inputFd >= 0) {
+        fcntl(inputFd, F_SETFL, fcntl(inputFd, F_GETFL) | O_NONBLOCK);
+    }
+}
+
+int SerialPort::available() {
+    if (peeked >= 0) {
+        return 1;
+    }
+
+    if (inputFd < 0) {
+        return 0;
+    }
+
+    pollfd pollFd = { inputFd, POLLIN, 0 };
+    if (poll(&pollFd, 1, 0) <= 0 || !(pollFd.revents & (POLLIN | POLLHUP))) {
+        return 0;
+    }
+
+    uint8_t c;
+    const ssize_t size = ::read(inputFd, &c, 1);
+    if (size == 0) {
+        inputFd = -1; // End of file, like an unplugged cable
+        return 0;
+    }
+
+    if (size == 1) {
+        peeked = c;
+    }
+
+    return peeked >= 0 ? 1 : 0;
+}
+
+int SerialPort::read() {
+    if (peeked >= 0) {
+        const int c = peeked;
+        peeked = -1;
+        return c;
+    }
+
+    uint8_t c;
+    if (inputFd < 0 || ::read(inputFd, &c, 1) != 1) {
+        return -1;
+    }
+
+    return c;
+}
+
+int SerialPort::peek() {
+    if (peeked < 0) {
+        peeked = read();
+    }
+
+    return peeked;
+}
+
+int SerialPort::availableForWrite() {
+    return outputFd >= 0 ? 4096 : 0;
+}
+
+void SerialPort::flush() {
+    if (outputFd >= 0) {
+        fsync(outputFd);
+    }
+}
+
+size_t SerialPort::write(const uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t SerialPort::write(const uint8_t *data, const size_t size) {
+    if (outputFd < 0) {
+        return size;
+    }
+
+    const ssize_t written = ::write(outputFd, data, size);
+    return written > 0 ? written : 0;
+}
+
+// Runtime
+
+static FILE *radioTxOutput = nullptr;
+
+static int openPort(const char *variable) {
+    const char *path = getenv(variable);
+
+    if (path == nullptr) {
+        return -1;
+    }
+
+    const int fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        fprintf(stderr, "[NATIVE] Fail to open %s=%s\n", variable, path);
+    }
+
+    return fd;
+}
+
+static void loadRadioFrames(const char *path) {
+    FILE *file = fopen(path, "r");
+
+    if (file == nullptr) {
+        fprintf(stderr, "[NATIVE] Fail to open LORA_SIM_RX=%s\n", path);
+        return;
+    }
+
+    char line[512];
+    uint8_t frame[RADIOLIB_SX126X_MAX_PACKET_LENGTH];
+
+    // One frame per line: "<millis after setup> <TNC2 text>", sent with the LoRa APRS "<\xFF\x01" header,
+    // or "<millis after setup> AX25 <TNC2 text>" sent as an AX.25 UI frame
+    while (fgets(line, sizeof(line), file) != nullptr) {
+        char *text = nullptr;
+        const unsigned long at = strtoul(line, &text, 10);
+
+        if (line[0] == '#' || text == line || *text != ' ') {
+            continue;
+        }
+
+        text++;
+        text[strcspn(text, "\r\n")] = '\0';
+
+        if (strncmp(text, "AX25 ", 5) == 0) {
+            text += 5;
+
+            if (const size_t size = Ax25::encode(text, strlen(text), frame, sizeof(frame)); size) {
+                RadioModel::inject(frame, size, -90, 8, millis() + at);
+            } else {
+                fprintf(stderr, "[NATIVE] Not an AX.25 frame in LORA_SIM_RX: %s\n", text);
+            }
+
+            continue;
+        }
+
+        const size_t size = std::min(strlen(text), sizeof(frame) - 3);
+        frame[0] = '<';
+        frame[1] = 0xFF;
+        frame[2] = 0x01;
+        memcpy(frame + 3, text, size);
+
+        RadioModel::inject(frame, size + 3, -90, 8, millis() + at);
+    }
+
+    fclose(file);
+}
+
+static void writeRadioFrame(const uint8_t *data, const size_t size, const RadioLibTime_t timeOnAir) {
+    fprintf(radioTxOutput, "%lu %lu ", millis(), static_cast<unsigned long>(timeOnAir / 1000));
+
+    for (size_t i = 0; i < size; i++) {
+        fputc(data[i] >= 0x20 && data[i] < 0x7F ? data[i] : '.', radioTxOutput);
+    }
+
+    fputc('\n', radioTxOutput);
+    fflush(radioTxOutput);
+}
+
+static void printStats() {
+    const RadioModelStats &radio = RadioModel::stats;
+    const FSStats &fs = LittleFS.stats;
+
+    fprintf(stderr, "[NATIVE] Radio: injected %u, delivered %u, missed %u, transmitted %u, airtime %llums\n",
+            radio.framesInjected, radio.framesDelivered, radio.framesMissed, radio.framesTransmitted,
+            static_cast<unsigned long long>(radio.airtimeTransmitted / 1000));
+    fprintf(stderr, "[NATIVE] LittleFS: opens %u, writes %u, bytes written %u, formats %u\n",
+            fs.opens, fs.writes, fs.bytesWritten, fs.formats);
+}
+
+static void onSignal(int) {
+    exit(0);
+}
+
+int main() {
+    Serial.bind(STDIN_FILENO, STDOUT_FILENO);
+
+    const int serial1 = openPort("SERIAL1_PATH");
+    Serial1.bind(serial1, serial1);
+
+    const int serial2 = openPort("SERIAL2_PATH");
+    Serial2.bind(serial2, serial2);
+
+    if (const char *path = getenv("LORA_SIM_TX"); path != nullptr) {
+        radioTxOutput = fopen(path, "a");
+    }
+
+    if (radioTxOutput == nullptr) {
+        radioTxOutput = stderr;
+    }
+
+    RadioModel::onTransmit = writeRadioFrame;
+
+    atexit(printStats);
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    setup();
+
+    isOnCore1 = true;
+    setup1();
+    isOnCore1 = false;
+    isCore1Started = true;
+
+    if (const char *path = getenv("LORA_SIM_RX"); path != nullptr) {
+        loadRadioFrames(path);
+    }
+
+    for (;;) {
+        RadioModel::poll();
+        loop();
+        runCore1();
+    }
+}
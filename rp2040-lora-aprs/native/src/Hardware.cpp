@@ -0,0 +1,201 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <Wire.h>
+#include <DS3231.h>
+#include <PicoSleep.h>
+#include "hardware/pll.h"
+#include "hardware/vreg.h"
+
+SPIClassRP2040 SPI;
+SPIClassRP2040 SPI1;
+
+TwoWire Wire;
+TwoWire Wire1;
+
+pll_hw_t *pll_sys = nullptr;
+pll_hw_t *pll_usb = nullptr;
+
+void pll_deinit(pll_hw_t *pll) {
+}
+
+void vreg_set_voltage(vreg_voltage voltage) {
+}
+
+void TwoWire::begin() {
+}
+
+void TwoWire::begin(uint8_t address) {
+}
+
+void TwoWire::end() {
+}
+
+void TwoWire::setClock(uint32_t frequency) {
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+}
+
+uint8_t TwoWire::endTransmission(bool stopBit) {
+    return 2; // Address NACK
+}
+
+size_t TwoWire::requestFrom(uint8_t address, size_t quantity, bool stopBit) {
+    return 0;
+}
+
+size_t TwoWire::write(uint8_t c) {
+    return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, const size_t size) {
+    return size;
+}
+
+int TwoWire::available() {
+    return 0;
+}
+
+int TwoWire::read() {
+    return -1;
+}
+
+int TwoWire::peek() {
+    return -1;
+}
+
+void TwoWire::onReceive(void (*callback)(int)) {
+    receiveCallback = callback;
+}
+
+void TwoWire::onRequest(void (*callback)()) {
+    requestCallback = callback;
+}
+
+// Internal RTC, kept as an offset from the host clock. Year is counted from 1900 like PicoSleep does
+static time_t internalRtcOffset = 0;
+static bool internalRtcRunning = false;
+
+void rtc_init() {
+    internalRtcRunning = true;
+}
+
+bool rtc_set_datetime(datetime_t *t) {
+    struct tm tm{};
+    tm.tm_year = t->year;
+    tm.tm_mon = t->month - 1;
+    tm.tm_mday = t->day;
+    tm.tm_hour = t->hour;
+    tm.tm_min = t->min;
+    tm.tm_sec = t->sec;
+
+    internalRtcOffset = timegm(&tm) - time(nullptr);
+    return true;
+}
+
+bool rtc_get_datetime(datetime_t *t) {
+    if (!internalRtcRunning) {
+        return false;
+    }
+
+    epoch_to_datetime(time(nullptr) + internalRtcOffset, t);
+    return true;
+}
+
+bool rtc_running() {
+    return internalRtcRunning;
+}
+
+void epoch_to_datetime(const time_t epoch, datetime_t *dt) {
+    struct tm tm{};
+    gmtime_r(&epoch, &tm);
+
+    dt->year = static_cast<int16_t>(tm.tm_year);
+    dt->month = static_cast<int8_t>(tm.tm_mon + 1);
+    dt->day = static_cast<int8_t>(tm.tm_mday);
+    dt->dotw = static_cast<int8_t>(tm.tm_wday);
+    dt->hour = static_cast<int8_t>(tm.tm_hour);
+    dt->min = static_cast<int8_t>(tm.tm_min);
+    dt->sec = static_cast<int8_t>(tm.tm_sec);
+}
+
+void cpuDeepSleep(const uint32_t msecs) {
+    // The board reboots when waking up from dormant
+    delay(msecs);
+    rp2040.reboot();
+}
+
+void lightSleepGateClocks(const bool keepUsb) {
+}
+
+void lightSleepEnableCore() {
+}
+
+time_t DS3231::offset = 0;
+
+DateTime::DateTime(const time_t unixtime) {
+    struct tm tm{};
+    gmtime_r(&unixtime, &tm);
+
+    yOff = tm.tm_year >= 100 ? tm.tm_year - 100 : 0;
+    m = tm.tm_mon + 1;
+    d = tm.tm_mday;
+    hh = tm.tm_hour;
+    mm = tm.tm_min;
+    ss = tm.tm_sec;
+}
+
+DateTime::DateTime(const uint16_t year, const uint8_t month, const uint8_t day, const uint8_t hour, const uint8_t minute, const uint8_t second) : yOff(year >= 2000 ? year - 2000 : year), m(month), d(day), hh(hour), mm(minute), ss(second) {
+}
+
+uint32_t DateTime::unixtime() const {
+    struct tm tm{};
+    tm.tm_year = yOff + 100;
+    tm.tm_mon = m - 1;
+    tm.tm_mday = d;
+    tm.tm_hour = hh;
+    tm.tm_min = mm;
+    tm.tm_sec = ss;
+
+    return static_cast<uint32_t>(timegm(&tm));
+}
+
+DateTime RTClib::now() {
+    return DateTime(time(nullptr) + DS3231::offset);
+}
+
+float DS3231::getTemperature() {
+    return 21.5;
+}
+
+void DS3231::setEpoch(const time_t epoch, bool flag_localtime) {
+    offset = epoch - time(nullptr);
+}
+
+void DS3231::setA1Time(const uint8_t day, const uint8_t hour, const uint8_t minute, const uint8_t second, uint8_t alarmBits, bool dayOfWeek, bool h12, bool pm) {
+    // Only the "once per day at hh:mm:ss" mode is used by the firmware
+    const DateTime now = RTClib::now();
+    time_t at = DateTime(now.year(), now.month(), now.day(), hour, minute, second).unixtime();
+    if (at <= static_cast<time_t>(now.unixtime())) {
+        at += 24 * 3600;
+    }
+
+    alarmAt = at;
+}
+
+void DS3231::turnOnAlarm(uint8_t alarm) {
+    alarmEnabled = true;
+}
+
+void DS3231::turnOffAlarm(uint8_t alarm) {
+    alarmEnabled = false;
+}
+
+bool DS3231::checkIfAlarm(uint8_t alarm, const bool clearFlag) {
+    const bool fired = alarmEnabled && alarmAt != 0 && time(nullptr) + offset >= alarmAt;
+    if (fired && clearFlag) {
+        alarmAt = 0;
+    }
+
+    return fired;
+}
@@ -0,0 +1,184 @@
+#include <LittleFS.h>
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+FS LittleFS;
+
+File::File(FILE *file) : file(file) {
+}
+
+size_t File::write(const uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t *data, const size_t size) {
+    if (file == nullptr) {
+        return 0;
+    }
+
+    const size_t written = fwrite(data, 1, size, file);
+
+    LittleFS.stats.writes++;
+    LittleFS.stats.bytesWritten += written;
+
+    return written;
+}
+
+int File::available() {
+    if (file == nullptr) {
+        return 0;
+    }
+
+    return static_cast<int>(size() - position());
+}
+
+int File::read() {
+    if (file == nullptr) {
+        return -1;
+    }
+
+    return fgetc(file);
+}
+
+int File::peek() {
+    if (file == nullptr) {
+        return -1;
+    }
+
+    const int c = fgetc(file);
+    if (c != EOF) {
+        ungetc(c, file);
+    }
+
+    return c;
+}
+
+void File::flush() {
+    if (file != nullptr) {
+        fflush(file);
+    }
+}
+
+size_t File::read(uint8_t *data, const size_t size) {
+    if (file == nullptr) {
+        return 0;
+    }
+
+    return fread(data, 1, size, file);
+}
+
+bool File::seek(const uint32_t position, const SeekMode mode) {
+    if (file == nullptr) {
+        return false;
+    }
+
+    const int whence = mode == SeekCur ? SEEK_CUR : mode == SeekEnd ? SEEK_END : SEEK_SET;
+    return fseek(file, position, whence) == 0;
+}
+
+size_t File::position() const {
+    if (file == nullptr) {
+        return 0;
+    }
+
+    return ftell(file);
+}
+
+size_t File::size() const {
+    if (file == nullptr) {
+        return 0;
+    }
+
+    struct stat st{};
+    fstat(fileno(file), &st);
+    return st.st_size;
+}
+
+void File::close() {
+    if (file != nullptr) {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+bool FS::begin() {
+    const char *path = getenv("LITTLEFS_ROOT");
+    strncpy(root, path != nullptr ? path : ".littlefs", sizeof(root) - 1);
+
+    mkdir(root, 0755);
+
+    struct stat st{};
+    return stat(root, &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+void FS::end() {
+}
+
+bool FS::format() {
+    DIR *dir = opendir(root);
+    if (dir == nullptr) {
+        return false;
+    }
+
+    char path[sizeof(root) + 256];
+    while (const dirent *entry = readdir(dir)) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+
+        snprintf(path, sizeof(path), "%s/%s", root, entry->d_name);
+        unlink(path);
+    }
+    closedir(dir);
+
+    stats.formats++;
+
+    return true;
+}
+
+File FS::open(const char *path, const char *mode) {
+    char hostPath[sizeof(root) + 256];
+    resolve(path, hostPath, sizeof(hostPath));
+
+    // Arduino modes are fopen ones, but binary is implicit
+    char hostMode[4]{};
+    strncpy(hostMode, mode, 2);
+    strcat(hostMode, "b");
+
+    FILE *file = fopen(hostPath, hostMode);
+    if (file != nullptr) {
+        stats.opens++;
+    }
+
+    return File(file);
+}
+
+bool FS::exists(const char *path) {
+    char hostPath[sizeof(root) + 256];
+    resolve(path, hostPath, sizeof(hostPath));
+
+    return access(hostPath, F_OK) == 0;
+}
+
+bool FS::remove(const char *path) {
+    char hostPath[sizeof(root) + 256];
+    resolve(path, hostPath, sizeof(hostPath));
+
+    return unlink(hostPath) == 0;
+}
+
+bool FS::rename(const char *pathFrom, const char *pathTo) {
+    char hostPathFrom[sizeof(root) + 256];
+    char hostPathTo[sizeof(root) + 256];
+    resolve(pathFrom, hostPathFrom, sizeof(hostPathFrom));
+    resolve(pathTo, hostPathTo, sizeof(hostPathTo));
+
+    return ::rename(hostPathFrom, hostPathTo) == 0;
+}
+
+void FS::resolve(const char *path, char *result, const size_t size) const {
+    // Flat namespace: "/config.dat" is stored as "<root>/config.dat"
+    snprintf(result, size, "%s/%s", root, path[0] == '/' ? path + 1 : path);
+}
@@ -0,0 +1,326 @@
+#include <RadioLib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+
+typedef struct {
+    uint8_t data[RADIOLIB_SX126X_MAX_PACKET_LENGTH];
+    size_t size;
+    float rssi;
+    float snr;
+    unsigned long start;
+    unsigned long end;
+} RadioModelFrame;
+
+static std::deque<RadioModelFrame> air;
+
+SX1262 *RadioModel::radio = nullptr;
+void (*RadioModel::onTransmit)(const uint8_t *data, size_t size, RadioLibTime_t timeOnAir) = nullptr;
+RadioModelStats RadioModel::stats{};
+
+RadioLibTime_t RadioModel::timeOnAir(const size_t size, const float bandwidth, const uint8_t spreadingFactor, const uint8_t codingRate, const uint16_t preambleLength) {
+    // Semtech AN1200.13 with explicit header and CRC on
+    const double symbolTime = (1 << spreadingFactor) / bandwidth; // ms
+    const uint8_t lowDataRateOptimize = symbolTime > 16 ? 1 : 0;
+    const double payloadSymbols = 8 + std::max(ceil((8.0 * size - 4.0 * spreadingFactor + 28 + 16) / (4.0 * (spreadingFactor - 2 * lowDataRateOptimize))) * codingRate, 0.0);
+
+    return static_cast<RadioLibTime_t>(((preambleLength + 4.25) + payloadSymbols) * symbolTime * 1000);
+}
+
+bool RadioModel::isChannelBusy() {
+    const unsigned long now = millis();
+
+    for (const auto &frame : air) {
+        if (frame.start <= now && now < frame.end) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool RadioModel::inject(const uint8_t *data, const size_t size, const float rssi, const float snr, const unsigned long at) {
+    if (size > RADIOLIB_SX126X_MAX_PACKET_LENGTH) {
+        return false;
+    }
+
+    RadioModelFrame frame{};
+    memcpy(frame.data, data, size);
+    frame.size = size;
+    frame.rssi = rssi;
+    frame.snr = snr;
+    frame.end = std::max(at, millis());
+
+    const auto duration = (radio != nullptr ? radio->getTimeOnAir(size) : timeOnAir(size, 125, 12, 5, 8)) / 1000;
+    frame.start = frame.end > duration ? frame.end - duration : 0;
+
+    const auto position = std::find_if(air.begin(), air.end(), [&frame](const RadioModelFrame &other) {
+        return other.end > frame.end;
+    });
+    air.insert(position, frame);
+
+    stats.framesInjected++;
+
+    return true;
+}
+
+void RadioModel::poll() {
+    if (radio == nullptr) {
+        return;
+    }
+
+    const unsigned long now = millis();
+
+    if ((radio->mode == RadioModelTransmit || radio->mode == RadioModelChannelScan) && now >= radio->operationEnd) {
+        if (radio->mode == RadioModelTransmit) {
+            radio->mode = RadioModelStandby;
+            radio->raise(RADIOLIB_SX126X_IRQ_TX_DONE);
+        } else {
+            radio->mode = RadioModelStandby;
+            radio->raise(RADIOLIB_SX126X_IRQ_CAD_DONE | (isChannelBusy() ? RADIOLIB_SX126X_IRQ_CAD_DETECTED : 0));
+        }
+    }
+
+    while (!air.empty() && air.front().end <= now) {
+        const RadioModelFrame &frame = air.front();
+
+        // Like the real chip, a frame is only heard when listening during all its preamble
+        if (radio->mode == RadioModelReceive && !(radio->irqFlags & RADIOLIB_SX126X_IRQ_RX_DONE)) {
+            memcpy(radio->rxData, frame.data, frame.size);
+            radio->rxLength = frame.size;
+            radio->rxRssi = frame.rssi;
+            radio->rxSnr = frame.snr;
+            stats.framesDelivered++;
+            radio->raise(RADIOLIB_SX126X_IRQ_RX_DONE);
+        } else {
+            stats.framesMissed++;
+        }
+
+        air.pop_front();
+    }
+}
+
+SX1262::SX1262(Module *module) {
+    RadioModel::radio = this;
+}
+
+void SX1262::raise(const uint32_t flags) {
+    irqFlags |= flags;
+
+    if (dio1Action != nullptr) {
+        dio1Action();
+    }
+}
+
+int16_t SX1262::begin(const float frequency, const float bandwidth, const uint8_t spreadingFactor, const uint8_t codingRate, uint8_t syncWord, const int8_t outputPower, const uint16_t preambleLength, float tcxoVoltage, bool useRegulatorLDO) {
+    int16_t state = setFrequency(frequency);
+    if (state == RADIOLIB_ERR_NONE) {
+        state = setBandwidth(bandwidth);
+    }
+    if (state == RADIOLIB_ERR_NONE) {
+        state = setSpreadingFactor(spreadingFactor);
+    }
+    if (state == RADIOLIB_ERR_NONE) {
+        state = setCodingRate(codingRate);
+    }
+    if (state == RADIOLIB_ERR_NONE) {
+        state = setOutputPower(outputPower);
+    }
+    if (state == RADIOLIB_ERR_NONE) {
+        state = setPreambleLength(preambleLength);
+    }
+
+    mode = RadioModelStandby;
+    irqFlags = 0;
+
+    return state;
+}
+
+void SX1262::setDio1Action(void (*function)()) {
+    dio1Action = function;
+}
+
+void SX1262::clearDio1Action() {
+    dio1Action = nullptr;
+}
+
+int16_t SX1262::setDio2AsRfSwitch(bool enable) {
+    return RADIOLIB_ERR_NONE;
+}
+
+void SX1262::setRfSwitchPins(uint32_t rxEn, uint32_t txEn) {
+}
+
+int16_t SX1262::setRxBoostedGainMode(bool rxbgm, bool persist) {
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t SX1262::setCRC(uint8_t len, uint16_t initial, uint16_t polynomial, bool inverted) {
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t SX1262::setCurrentLimit(float currentLimit) {
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t SX1262::setFrequency(const float frequency) {
+    if (frequency < 150 || frequency > 960) {
+        return RADIOLIB_ERR_INVALID_FREQUENCY;
+    }
+
+    this->frequency = frequency;
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t SX1262::setBandwidth(const float bandwidth) {
+    if (bandwidth < 7 || bandwidth > 500) {
+        return RADIOLIB_ERR_INVALID_BANDWIDTH;
+    }
+
+    this->bandwidth = bandwidth;
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t SX1262::setSpreadingFactor(const uint8_t spreadingFactor) {
+    if (spreadingFactor < 5 || spreadingFactor > 12) {
+        return RADIOLIB_ERR_INVALID_SPREADING_FACTOR;
+    }
+
+    this->spreadingFactor = spreadingFactor;
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t SX1262::setCodingRate(const uint8_t codingRate) {
+    if (codingRate < 5 || codingRate > 8) {
+        return RADIOLIB_ERR_INVALID_CODING_RATE;
+    }
+
+    this->codingRate = codingRate;
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t SX1262::setOutputPower(const int8_t power) {
+    if (power < -9 || power > 22) {
+        return RADIOLIB_ERR_INVALID_OUTPUT_POWER;
+    }
+
+    outputPower = power;
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t SX1262::setPreambleLength(const size_t preambleLength) {
+    this->preambleLength = preambleLength;
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t SX1262::standby() {
+    mode = RadioModelStandby;
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t SX1262::sleep(bool retainConfig) {
+    mode = RadioModelStandby;
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t SX1262::transmit(const uint8_t *data, const size_t len, const uint8_t addr) {
+    const int16_t state = startTransmit(data, len, addr);
+    if (state != RADIOLIB_ERR_NONE) {
+        return state;
+    }
+
+    // Blocking like RadioLib: wait the time on air
+    while (mode == RadioModelTransmit) {
+        delay(1);
+    }
+
+    return finishTransmit();
+}
+
+int16_t SX1262::startTransmit(const uint8_t *data, const size_t len, uint8_t addr) {
+    if (len > RADIOLIB_SX126X_MAX_PACKET_LENGTH) {
+        return RADIOLIB_ERR_PACKET_TOO_LONG;
+    }
+
+    const RadioLibTime_t timeOnAir = getTimeOnAir(len);
+
+    mode = RadioModelTransmit;
+    irqFlags = 0;
+    operationEnd = millis() + timeOnAir / 1000;
+
+    RadioModel::stats.framesTransmitted++;
+    RadioModel::stats.airtimeTransmitted += timeOnAir;
+
+    if (RadioModel::onTransmit != nullptr) {
+        RadioModel::onTransmit(data, len, timeOnAir);
+    }
+
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t SX1262::finishTransmit() {
+    irqFlags = 0;
+    return standby();
+}
+
+int16_t SX1262::startReceive() {
+    mode = RadioModelReceive;
+    irqFlags = 0;
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t SX1262::startReceiveDutyCycleAuto(uint16_t senderPreambleLength, uint16_t minSymbols, RadioLibIrqFlags_t irqFlags, uint32_t irqMask) {
+    return startReceive();
+}
+
+size_t SX1262::getPacketLength(bool update) {
+    return rxLength;
+}
+
+int16_t SX1262::readData(uint8_t *data, const size_t len) {
+    memcpy(data, rxData, std::min(len, rxLength));
+    irqFlags = 0;
+    return RADIOLIB_ERR_NONE;
+}
+
+float SX1262::getRSSI() {
+    return rxRssi;
+}
+
+float SX1262::getSNR() {
+    return rxSnr;
+}
+
+int16_t SX1262::scanChannel() {
+    mode = RadioModelStandby;
+    return RadioModel::isChannelBusy() ? RADIOLIB_LORA_DETECTED : RADIOLIB_CHANNEL_FREE;
+}
+
+int16_t SX1262::startChannelScan() {
+    mode = RadioModelChannelScan;
+    irqFlags = 0;
+    operationEnd = millis() + 2 * (1 << spreadingFactor) / static_cast<unsigned long>(bandwidth) + 1; // CAD on 2 symbols
+    return RADIOLIB_ERR_NONE;
+}
+
+int16_t SX1262::getChannelScanResult() {
+    if (!(irqFlags & RADIOLIB_SX126X_IRQ_CAD_DONE)) {
+        return RADIOLIB_ERR_UNKNOWN;
+    }
+
+    return irqFlags & RADIOLIB_SX126X_IRQ_CAD_DETECTED ? RADIOLIB_LORA_DETECTED : RADIOLIB_CHANNEL_FREE;
+}
+
+uint32_t SX1262::getIrqFlags() {
+    return irqFlags;
+}
+
+int16_t SX1262::clearIrqFlags(const uint32_t flags) {
+    irqFlags &= ~flags;
+    return RADIOLIB_ERR_NONE;
+}
+
+RadioLibTime_t SX1262::getTimeOnAir(const size_t len) {
+    return RadioModel::timeOnAir(len, bandwidth, spreadingFactor, codingRate, preambleLength);
+}
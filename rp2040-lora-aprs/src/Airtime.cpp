@@ -0,0 +1,58 @@
+#include "Airtime.h"
+
+uint32_t Airtime::timeOnAir(const size_t size, const SettingsLoRa &settings) {
+    // Semtech AN1200.13, explicit header and CRC on like Communication::begin()
+    const uint8_t spreadingFactor = settings.spreadingFactor;
+    const float symbolTime = static_cast<float>(1 << spreadingFactor) / settings.bandwidth; // ms
+    const uint8_t lowDataRateOptimize = symbolTime >= 16 ? 1 : 0; // RadioLib enables it automatically
+    const int32_t payloadBits = 8 * static_cast<int32_t>(size) - 4 * spreadingFactor + 28 + 16;
+    const int32_t bitsPerSymbol = 4 * (spreadingFactor - 2 * lowDataRateOptimize);
+
+    uint32_t payloadSymbols = 8;
+    if (payloadBits > 0) {
+        payloadSymbols += (payloadBits + bitsPerSymbol - 1) / bitsPerSymbol * settings.codingRate;
+    }
+
+    return static_cast<uint32_t>((LORA_PREAMBLE_LENGTH + 4.25f + payloadSymbols) * symbolTime);
+}
+
+void Airtime::add(const uint32_t milliseconds) {
+    const uint32_t minute = millis() / 60000;
+    const uint8_t bucket = minute % AIRTIME_WINDOW_MINUTES;
+
+    if (minutes[bucket] != minute) {
+        minutes[bucket] = minute;
+        buckets[bucket] = 0;
+    }
+
+    buckets[bucket] += milliseconds;
+    total += milliseconds;
+}
+
+bool Airtime::isAllowed(const uint32_t milliseconds, const uint16_t dutyCyclePerMille, const uint8_t budgetPercent) const {
+    if (dutyCyclePerMille == 0) {
+        return true;
+    }
+
+    const uint32_t budget = static_cast<uint64_t>(AIRTIME_WINDOW_MINUTES) * 60000 * dutyCyclePerMille / 1000 * budgetPercent / 100;
+
+    return lastHour() + milliseconds <= budget;
+}
+
+uint32_t Airtime::lastHour() const {
+    const uint32_t minute = millis() / 60000;
+    uint32_t window = 0;
+
+    // Nothing is changed by reading, so the main core can read it while the radio core sends
+    for (uint8_t i = 0; i < AIRTIME_WINDOW_MINUTES; i++) {
+        if (minute - minutes[i] < AIRTIME_WINDOW_MINUTES) {
+            window += buckets[i];
+        }
+    }
+
+    return window;
+}
+
+uint16_t Airtime::dutyCyclePerMille() const {
+    return static_cast<uint16_t>(static_cast<uint64_t>(lastHour()) * 1000 / (AIRTIME_WINDOW_MINUTES * 60000));
+}
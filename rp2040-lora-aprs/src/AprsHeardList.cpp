@@ -0,0 +1,416 @@
+#include <algorithm>
+#include <cstddef>
+
+#include "AprsHeardList.h"
+#include "Logging.h"
+#include "SettingsLegacy.h"
+#include "utils.h"
+
+#define APRS_HEARD_LOG_MAGIC 0x44524548 // HERD
+#define APRS_HEARD_LOG_VERSION 2
+#define APRS_HEARD_LEGACY_NUMBER 30
+
+static_assert(MAX_PACKET_LENGTH - 1 <= UINT8_MAX, "The length of a packet is written on one byte");
+
+// With its end of string, whatever the range of the length read
+static bool fitsPacket(const size_t length) {
+    return length < MAX_PACKET_LENGTH;
+}
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;
+} AprsHeardLogHeader;
+
+// Layout of the list when it was stored at the end of config.dat
+typedef struct {
+    char callsign[CALLSIGN_LENGTH];
+    time_t time;
+    float rssi;
+    float snr;
+    char content[MAX_PACKET_LENGTH];
+    uint64_t count;
+    char digipeaterCallsign[CALLSIGN_LENGTH];
+    uint8_t digipeaterCount;
+
+    uint8_t reserved[128];
+} AprsHeardLegacy;
+
+static constexpr AprsHeardLogHeader logHeader = {APRS_HEARD_LOG_MAGIC, APRS_HEARD_LOG_VERSION, sizeof(AprsHeard)};
+
+static_assert((APRS_HEARD_INDEX_SIZE & (APRS_HEARD_INDEX_SIZE - 1)) == 0, "Index size must be a power of 2");
+static_assert(APRS_HEARD_INDEX_SIZE > APRS_HEARD_STATIONS, "Index must have empty slots to end probes");
+static_assert(APRS_HEARD_PACKETS < 0xFF, "Packet slots are on uint8_t");
+
+bool AprsHeardList::begin() {
+    const bool ok = load();
+
+    uint16_t position = 0;
+    for (auto station = first(); station != nullptr; station = next(station)) {
+        getDateTimeStringFromEpoch(station->time, bufferText, BUFFER_LENGTH);
+        LOG_TRACE(F("[APRS_HEARD] #%d at %s from %s with SNR %F and RSSI %F, content: %s. Digi (%d) and last via %s. Count total %u"), position++, bufferText, station->callsign, station->snr, station->rssi, getPacket(station), station->digipeaterCount, station->digipeaterCallsign, station->count);
+    }
+
+    return ok;
+}
+
+uint16_t AprsHeardList::hash(const char *callsign) {
+    // FNV-1a, case insensitive like the queries
+    uint32_t hash = 2166136261;
+
+    for (; *callsign != '\0'; callsign++) {
+        hash ^= static_cast<uint8_t>(toupper(*callsign));
+        hash *= 16777619;
+    }
+
+    return hash & (APRS_HEARD_INDEX_SIZE - 1);
+}
+
+uint16_t AprsHeardList::findIndex(const char *callsign) const {
+    for (uint16_t position = hash(callsign); index[position] != 0; position = (position + 1) & (APRS_HEARD_INDEX_SIZE - 1)) {
+        if (strcasecmp(stations[index[position] - 1].callsign, callsign) == 0) {
+            return position;
+        }
+    }
+
+    return NONE;
+}
+
+AprsHeard *AprsHeardList::find(const char *callsign) const {
+    const uint16_t position = findIndex(callsign);
+
+    return position == NONE ? nullptr : const_cast<AprsHeard *>(&stations[index[position] - 1]);
+}
+
+AprsHeard *AprsHeardList::upsert(const char *callsign) {
+    uint16_t station;
+
+    if (const uint16_t position = findIndex(callsign); position != NONE) {
+        station = index[position] - 1;
+        unlink(station);
+    } else {
+        if (count < APRS_HEARD_STATIONS) {
+            station = count++;
+        } else {
+            station = lruTail;
+            evict();
+        }
+
+        memset(&stations[station], 0, sizeof(AprsHeard));
+        strncpy(stations[station].callsign, callsign, CALLSIGN_LENGTH - 1);
+        packetSlot[station] = NO_PACKET;
+
+        uint16_t empty = hash(callsign);
+        while (index[empty] != 0) {
+            empty = (empty + 1) & (APRS_HEARD_INDEX_SIZE - 1);
+        }
+        index[empty] = station + 1;
+    }
+
+    pushFront(station);
+
+    return &stations[station];
+}
+
+void AprsHeardList::evict() {
+    const uint16_t station = lruTail;
+    uint16_t hole = findIndex(stations[station].callsign);
+
+    // Backward shift deletion, so probes of the following entries still end on them
+    for (uint16_t position = (hole + 1) & (APRS_HEARD_INDEX_SIZE - 1); index[position] != 0; position = (position + 1) & (APRS_HEARD_INDEX_SIZE - 1)) {
+        const uint16_t home = hash(stations[index[position] - 1].callsign);
+
+        if (((position - home) & (APRS_HEARD_INDEX_SIZE - 1)) >= ((position - hole) & (APRS_HEARD_INDEX_SIZE - 1))) {
+            index[hole] = index[position];
+            hole = position;
+        }
+    }
+    index[hole] = 0;
+
+    unlink(station);
+
+    if (packetSlot[station] != NO_PACKET) {
+        packetOwner[packetSlot[station]] = 0;
+    }
+
+    dirty[station] = false;
+    stats.evicted++;
+}
+
+void AprsHeardList::unlink(const uint16_t station) {
+    const uint16_t previous = lruPrevious[station];
+    const uint16_t following = lruNext[station];
+
+    if (previous != NONE) {
+        lruNext[previous] = following;
+    } else {
+        lruHead = following;
+    }
+
+    if (following != NONE) {
+        lruPrevious[following] = previous;
+    } else {
+        lruTail = previous;
+    }
+}
+
+void AprsHeardList::pushFront(const uint16_t station) {
+    lruPrevious[station] = NONE;
+    lruNext[station] = lruHead;
+
+    if (lruHead != NONE) {
+        lruPrevious[lruHead] = station;
+    } else {
+        lruTail = station;
+    }
+
+    lruHead = station;
+}
+
+void AprsHeardList::setPacket(const uint16_t station, const char *packet, size_t length) {
+    uint8_t slot = packetSlot[station];
+
+    if (slot == NO_PACKET) {
+        slot = packetNext;
+        packetNext = (packetNext + 1) % APRS_HEARD_PACKETS;
+
+        if (packetOwner[slot] != 0) {
+            packetSlot[packetOwner[slot] - 1] = NO_PACKET;
+        }
+
+        packetOwner[slot] = station + 1;
+        packetSlot[station] = slot;
+    }
+
+    if (length >= MAX_PACKET_LENGTH) {
+        length = MAX_PACKET_LENGTH - 1;
+    }
+
+    memcpy(packets[slot], packet, length);
+    packets[slot][length] = '\0';
+}
+
+const char *AprsHeardList::getPacket(const AprsHeard *station) const {
+    const uint8_t slot = packetSlot[station - stations];
+
+    return slot == NO_PACKET ? "" : packets[slot];
+}
+
+AprsHeard *AprsHeardList::first() const {
+    return lruHead == NONE ? nullptr : const_cast<AprsHeard *>(&stations[lruHead]);
+}
+
+AprsHeard *AprsHeardList::next(const AprsHeard *station) const {
+    const uint16_t following = lruNext[station - stations];
+
+    return following == NONE ? nullptr : const_cast<AprsHeard *>(&stations[following]);
+}
+
+AprsHeard *AprsHeardList::add(const AprsPacketLite *packet, const uint32_t time, const float snr, const float rssi) {
+    AprsHeard *station = upsert(packet->source);
+    const uint16_t position = station - stations;
+
+    station->time = time;
+    station->snr = snr;
+    station->rssi = rssi;
+    station->count++;
+    station->digipeaterCount = packet->digipeaterCount;
+    strncpy(station->digipeaterCallsign, packet->lastDigipeaterCallsignInPath, CALLSIGN_LENGTH - 1);
+    setPacket(position, packet->raw, strlen(packet->raw));
+
+    dirty[position] = true;
+
+    if (timerFlush.isPaused()) {
+        timerFlush.restart();
+    }
+
+    return station;
+}
+
+void AprsHeardList::clear() {
+    memset(stations, 0, sizeof(stations));
+    memset(index, 0, sizeof(index));
+    memset(packetOwner, 0, sizeof(packetOwner));
+    memset(dirty, 0, sizeof(dirty));
+    count = 0;
+    lruHead = NONE;
+    lruTail = NONE;
+    packetNext = 0;
+    timerFlush.pause();
+
+    compact();
+}
+
+bool AprsHeardList::writeRecord(File &file, const uint16_t station) {
+    const char *packet = getPacket(&stations[station]);
+    const uint8_t length = std::min<size_t>(strlen(packet), MAX_PACKET_LENGTH - 1);
+
+    return file.write(reinterpret_cast<const uint8_t *>(&stations[station]), sizeof(AprsHeard)) == sizeof(AprsHeard)
+        && file.write(&length, sizeof(length)) == sizeof(length)
+        && file.write(reinterpret_cast<const uint8_t *>(packet), length) == length;
+}
+
+bool AprsHeardList::flush(const bool force) {
+    if (timerFlush.isPaused() || (!force && !timerFlush.hasExpired())) {
+        return true;
+    }
+
+    timerFlush.pause();
+
+    uint16_t dirtyCount = 0;
+    for (const auto isDirty : dirty) {
+        dirtyCount += isDirty;
+    }
+
+    if (recordsInLog + dirtyCount > APRS_HEARD_LOG_MAX_RECORDS) {
+        return compact();
+    }
+
+    File file = LittleFS.open("/heard.dat", "a");
+    if (!file) {
+        Log.errorln(F("[APRS_HEARD] Fail to open log"));
+        return false;
+    }
+
+    if (file.size() == 0) {
+        file.write(reinterpret_cast<const uint8_t *>(&logHeader), sizeof(logHeader));
+    }
+
+    // Oldest first, so the replay rebuilds the same recency order
+    for (uint16_t station = lruTail; station != NONE; station = lruPrevious[station]) {
+        if (dirty[station]) {
+            writeRecord(file, station);
+            dirty[station] = false;
+            recordsInLog++;
+            stats.appended++;
+        }
+    }
+
+    file.close();
+    stats.flushes++;
+
+    Log.infoln(F("[APRS_HEARD] %d stations appended to log, %d records in it"), dirtyCount, recordsInLog);
+
+    return true;
+}
+
+bool AprsHeardList::load() {
+    File file = LittleFS.open("/heard.dat", "r");
+    if (!file) {
+        return migrate();
+    }
+
+    AprsHeardLogHeader header{};
+    if (file.read(reinterpret_cast<uint8_t *>(&header), sizeof(header)) != sizeof(header) || header.magic != logHeader.magic || header.version != logHeader.version || header.recordSize != logHeader.recordSize) {
+        file.close();
+        Log.warningln(F("[APRS_HEARD] Log not compatible, we start a new one"));
+        return compact();
+    }
+
+    // Records are in order of reception, the last one of a station is its state
+    AprsHeard record{};
+    uint8_t length;
+    char packet[MAX_PACKET_LENGTH];
+
+    size_t end = file.position(); // Of the last complete record
+
+    while (file.read(reinterpret_cast<uint8_t *>(&record), sizeof(record)) == sizeof(record)
+        && file.read(&length, sizeof(length)) == sizeof(length)
+        && fitsPacket(length)
+        && file.read(reinterpret_cast<uint8_t *>(packet), length) == length
+        && memchr(packet, '\0', length) == nullptr) { // A packet is text, else the length is corrupted
+        record.callsign[CALLSIGN_LENGTH - 1] = '\0';
+        record.digipeaterCallsign[CALLSIGN_LENGTH - 1] = '\0';
+
+        AprsHeard *station = upsert(record.callsign);
+        *station = record;
+
+        if (length > 0) {
+            setPacket(station - stations, packet, length);
+        }
+
+        recordsInLog++;
+        end = file.position();
+    }
+
+    const bool isTorn = end != file.size();
+    file.close();
+
+    Log.infoln(F("[APRS_HEARD] Read %d records from log for %d stations"), recordsInLog, count);
+
+    // Cut by a power loss during an append, the next ones would be written after the torn bytes and lost
+    if (isTorn) {
+        Log.warningln(F("[APRS_HEARD] Log torn after %d records, compacted"), recordsInLog);
+        return compact();
+    }
+
+    return true;
+}
+
+bool AprsHeardList::migrate() {
+    // The list was just after useSlowClock, aligned for its time_t and uint64_t
+    constexpr size_t legacyOffset = (offsetof(SettingsLegacy, reserved) + alignof(AprsHeardLegacy) - 1) / alignof(AprsHeardLegacy) * alignof(AprsHeardLegacy);
+
+    File file = LittleFS.open("/config.dat", "r");
+    if (file && file.size() >= legacyOffset + sizeof(AprsHeardLegacy) * APRS_HEARD_LEGACY_NUMBER && file.seek(legacyOffset)) {
+        AprsHeardLegacy legacy{};
+
+        for (uint8_t i = 0; i < APRS_HEARD_LEGACY_NUMBER; i++) {
+            file.read(reinterpret_cast<uint8_t *>(&legacy), sizeof(legacy));
+            legacy.callsign[CALLSIGN_LENGTH - 1] = '\0';
+            legacy.content[MAX_PACKET_LENGTH - 1] = '\0';
+
+            if (strlen(legacy.callsign) == 0) {
+                continue;
+            }
+
+            AprsHeard *station = upsert(legacy.callsign);
+            station->time = legacy.time;
+            station->rssi = legacy.rssi;
+            station->snr = legacy.snr;
+            station->count = legacy.count;
+            memcpy(station->digipeaterCallsign, legacy.digipeaterCallsign, CALLSIGN_LENGTH - 1);
+            station->digipeaterCount = legacy.digipeaterCount;
+            setPacket(station - stations, legacy.content, strlen(legacy.content));
+        }
+
+        Log.infoln(F("[APRS_HEARD] Migrated %d stations from config"), count);
+    }
+
+    if (file) {
+        file.close();
+    }
+
+    return compact();
+}
+
+bool AprsHeardList::compact() {
+    File file = LittleFS.open("/heard.tmp", "w");
+    if (!file) {
+        Log.errorln(F("[APRS_HEARD] Fail to compact log"));
+        return false;
+    }
+
+    file.write(reinterpret_cast<const uint8_t *>(&logHeader), sizeof(logHeader));
+
+    recordsInLog = 0;
+    for (uint16_t station = lruTail; station != NONE; station = lruPrevious[station]) {
+        writeRecord(file, station);
+        recordsInLog++;
+    }
+
+    file.close();
+    memset(dirty, 0, sizeof(dirty));
+
+    if (!LittleFS.rename("/heard.tmp", "/heard.dat")) {
+        Log.errorln(F("[APRS_HEARD] Fail to replace log"));
+        return false;
+    }
+
+    stats.compactions++;
+
+    Log.infoln(F("[APRS_HEARD] Log compacted to %d records"), recordsInLog);
+
+    return true;
+}
@@ -0,0 +1,244 @@
+#include <cstring>
+#include "Ax25.h"
+
+#define AX25_SSID_RESERVED 0x60
+#define AX25_SSID_COMMAND 0x80 // On the destination, a UI frame is a command
+#define AX25_SSID_REPEATED 0x80 // On a digipeater
+#define AX25_ADDRESS_LAST 0x01
+
+static bool isAddressCharacter(const char character) {
+    return (character >= 'A' && character <= 'Z') || (character >= '0' && character <= '9');
+}
+
+size_t Ax25::encode(const char *text, const size_t length, uint8_t *out, const size_t outSize) {
+    const auto headerEnd = static_cast<const char *>(memchr(text, ':', length));
+
+    if (headerEnd == nullptr) {
+        return 0;
+    }
+
+    const auto sourceEnd = static_cast<const char *>(memchr(text, '>', headerEnd - text));
+
+    if (sourceEnd == nullptr) {
+        return 0;
+    }
+
+    const size_t informationSize = text + length - (headerEnd + 1);
+    bool repeated;
+
+    // Destination before the source, whatever the text order
+    const char *destination = sourceEnd + 1;
+    auto destinationEnd = static_cast<const char *>(memchr(destination, ',', headerEnd - destination));
+
+    if (destinationEnd == nullptr) {
+        destinationEnd = headerEnd;
+    }
+
+    if (outSize < AX25_HEADER_MIN + informationSize
+        || !encodeAddress(destination, destinationEnd - destination, out, &repeated) || repeated
+        || !encodeAddress(text, sourceEnd - text, out + AX25_ADDRESS_LENGTH, &repeated) || repeated) {
+        return 0;
+    }
+
+    out[AX25_ADDRESS_LENGTH - 1] |= AX25_SSID_COMMAND;
+
+    size_t position = 2 * AX25_ADDRESS_LENGTH;
+    uint8_t digipeaters = 0;
+    int8_t lastRepeated = -1;
+
+    for (const char *digipeater = destinationEnd; digipeater < headerEnd;) {
+        digipeater++; // ','
+
+        auto digipeaterEnd = static_cast<const char *>(memchr(digipeater, ',', headerEnd - digipeater));
+
+        if (digipeaterEnd == nullptr) {
+            digipeaterEnd = headerEnd;
+        }
+
+        if (digipeaters == AX25_DIGIPEATERS_MAX || outSize < position + AX25_ADDRESS_LENGTH + 2 + informationSize
+            || !encodeAddress(digipeater, digipeaterEnd - digipeater, out + position, &repeated)) {
+            return 0;
+        }
+
+        if (repeated) {
+            lastRepeated = static_cast<int8_t>(digipeaters);
+        }
+
+        position += AX25_ADDRESS_LENGTH;
+        digipeaters++;
+        digipeater = digipeaterEnd;
+    }
+
+    for (int8_t i = 0; i <= lastRepeated; i++) {
+        out[(2 + i + 1) * AX25_ADDRESS_LENGTH - 1] |= AX25_SSID_REPEATED;
+    }
+
+    out[position - 1] |= AX25_ADDRESS_LAST;
+    out[position++] = AX25_CONTROL_UI;
+    out[position++] = AX25_PID_NO_LAYER3;
+
+    memcpy(out + position, headerEnd + 1, informationSize);
+
+    return position + informationSize;
+}
+
+size_t Ax25::decode(const uint8_t *frame, const size_t size, char *out, const size_t outSize) {
+    size_t addresses = 0;
+
+    do {
+        if ((addresses + 1) * AX25_ADDRESS_LENGTH + 2 > size || addresses == 2 + AX25_DIGIPEATERS_MAX) {
+            return 0;
+        }
+
+        addresses++;
+    } while (!(frame[addresses * AX25_ADDRESS_LENGTH - 1] & AX25_ADDRESS_LAST));
+
+    const size_t headerSize = addresses * AX25_ADDRESS_LENGTH;
+
+    if (addresses < 2 || frame[headerSize] != AX25_CONTROL_UI || frame[headerSize + 1] != AX25_PID_NO_LAYER3) {
+        return 0;
+    }
+
+    const size_t informationSize = size - headerSize - 2;
+
+    // Each address is written in at most "CALLSG-15*," and ':' ends the header
+    if (addresses * 11 + informationSize + 1 > outSize) {
+        return 0;
+    }
+
+    size_t position = 0;
+    size_t written;
+
+    if ((written = decodeAddress(frame + AX25_ADDRESS_LENGTH, out)) == 0) {
+        return 0;
+    }
+
+    position += written;
+    out[position++] = '>';
+
+    if ((written = decodeAddress(frame, out + position)) == 0) {
+        return 0;
+    }
+
+    position += written;
+
+    size_t lastRepeated = 0; // 0 when none, as the first digipeater is the third address
+
+    for (size_t i = 2; i < addresses; i++) {
+        if (frame[(i + 1) * AX25_ADDRESS_LENGTH - 1] & AX25_SSID_REPEATED) {
+            lastRepeated = i;
+        }
+    }
+
+    for (size_t i = 2; i < addresses; i++) {
+        out[position++] = ',';
+
+        if ((written = decodeAddress(frame + i * AX25_ADDRESS_LENGTH, out + position)) == 0) {
+            return 0;
+        }
+
+        position += written;
+
+        if (i == lastRepeated) {
+            out[position++] = '*';
+        }
+    }
+
+    out[position++] = ':';
+    memcpy(out + position, frame + headerSize + 2, informationSize);
+    position += informationSize;
+    out[position] = '\0';
+
+    return position;
+}
+
+bool Ax25::encodeAddress(const char *address, size_t length, uint8_t *out, bool *repeated) {
+    *repeated = length > 0 && address[length - 1] == '*';
+
+    if (*repeated) {
+        length--;
+    }
+
+    const auto callsignEnd = static_cast<const char *>(memchr(address, '-', length));
+    const size_t callsignLength = callsignEnd != nullptr ? callsignEnd - address : length;
+
+    if (callsignLength == 0 || callsignLength > AX25_CALLSIGN_LENGTH) {
+        return false;
+    }
+
+    uint8_t ssid = 0;
+
+    if (callsignEnd != nullptr) {
+        const size_t ssidLength = length - callsignLength - 1;
+
+        if (ssidLength == 0 || ssidLength > 2) {
+            return false;
+        }
+
+        for (size_t i = 0; i < ssidLength; i++) {
+            const char digit = callsignEnd[1 + i];
+
+            if (digit < '0' || digit > '9') {
+                return false;
+            }
+
+            ssid = ssid * 10 + (digit - '0');
+        }
+
+        if (ssid > 15) {
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < AX25_CALLSIGN_LENGTH; i++) {
+        if (i < callsignLength && !isAddressCharacter(address[i])) {
+            return false;
+        }
+
+        out[i] = (i < callsignLength ? address[i] : ' ') << 1;
+    }
+
+    out[AX25_CALLSIGN_LENGTH] = AX25_SSID_RESERVED | ssid << 1;
+
+    return true;
+}
+
+size_t Ax25::decodeAddress(const uint8_t *address, char *out) {
+    size_t length = 0;
+
+    for (size_t i = 0; i < AX25_CALLSIGN_LENGTH; i++) {
+        if (address[i] & 0x01) {
+            return 0;
+        }
+
+        const char character = static_cast<char>(address[i] >> 1);
+
+        if (character == ' ') {
+            continue;
+        }
+
+        // Spaces are only allowed to pad the end
+        if (!isAddressCharacter(character) || length != i) {
+            return 0;
+        }
+
+        out[length++] = character;
+    }
+
+    if (length == 0) {
+        return 0;
+    }
+
+    const uint8_t ssid = address[AX25_CALLSIGN_LENGTH] >> 1 & 0x0F;
+
+    if (ssid >= 10) {
+        out[length++] = '-';
+        out[length++] = '1';
+        out[length++] = static_cast<char>('0' + ssid - 10);
+    } else if (ssid > 0) {
+        out[length++] = '-';
+        out[length++] = static_cast<char>('0' + ssid);
+    }
+
+    return length;
+}
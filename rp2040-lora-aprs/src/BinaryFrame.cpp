@@ -0,0 +1,123 @@
+#include "BinaryFrame.h"
+
+size_t BinaryFrame::encode(const BinaryMessageType type, const void *payload, const uint16_t length, uint8_t *out) {
+    if (length > BINARY_FRAME_PAYLOAD_MAX) {
+        return 0;
+    }
+
+    const uint8_t header[BINARY_FRAME_HEADER] = {type, static_cast<uint8_t>(length), static_cast<uint8_t>(length >> 8)};
+    const uint16_t crc = crc16(static_cast<const uint8_t *>(payload), length, crc16(header, sizeof(header)));
+    const uint8_t trailer[BINARY_FRAME_CRC] = {static_cast<uint8_t>(crc), static_cast<uint8_t>(crc >> 8)};
+
+    const size_t end = BINARY_FRAME_HEADER + static_cast<size_t>(length);
+
+    size_t position = 0;
+    out[position++] = 0;
+
+    size_t codePosition = position++;
+    uint8_t code = 1;
+
+    // Read in three parts, so the payload is not copied before being encoded
+    for (size_t i = 0; i < end + BINARY_FRAME_CRC; i++) {
+        uint8_t byte;
+
+        if (i < BINARY_FRAME_HEADER) {
+            byte = header[i];
+        } else if (i < end) {
+            byte = static_cast<const uint8_t *>(payload)[i - BINARY_FRAME_HEADER];
+        } else {
+            byte = trailer[i - end];
+        }
+
+        if (byte != 0) {
+            out[position++] = byte;
+            code++;
+        }
+
+        if (byte == 0 || code == 0xFF) {
+            out[codePosition] = code;
+            codePosition = position++;
+            code = 1;
+        }
+    }
+
+    out[codePosition] = code;
+    out[position++] = 0;
+
+    return position;
+}
+
+uint16_t BinaryFrame::crc16(const uint8_t *data, const size_t length, uint16_t crc) {
+    for (size_t i = 0; i < length; i++) {
+        crc ^= static_cast<uint16_t>(data[i]) << 8;
+
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = crc & 0x8000 ? crc << 1 ^ 0x1021 : crc << 1;
+        }
+    }
+
+    return crc;
+}
+
+bool BinaryFrameDecoder::push(const uint8_t byte) {
+    if (byte != 0) {
+        if (size < sizeof(buffer)) {
+            buffer[size++] = byte;
+        } else {
+            overflow = true;
+        }
+
+        return false;
+    }
+
+    if (size == 0) { // Leading delimiter or two in a row
+        return false;
+    }
+
+    const bool valid = !overflow && decode();
+
+    if (!valid) {
+        errors++;
+    }
+
+    size = 0;
+    overflow = false;
+
+    return valid;
+}
+
+bool BinaryFrameDecoder::decode() {
+    // In place, the decoded frame is never longer than the encoded one
+    size_t read = 0;
+    size_t written = 0;
+
+    while (read < size) {
+        const uint8_t code = buffer[read++];
+
+        for (uint8_t i = 1; i < code; i++) {
+            if (read >= size) {
+                return false;
+            }
+
+            buffer[written++] = buffer[read++];
+        }
+
+        if (code != 0xFF && read < size) {
+            buffer[written++] = 0;
+        }
+    }
+
+    if (written < BINARY_FRAME_HEADER + BINARY_FRAME_CRC) {
+        return false;
+    }
+
+    length = buffer[1] | buffer[2] << 8;
+
+    if (written != BINARY_FRAME_HEADER + static_cast<size_t>(length) + BINARY_FRAME_CRC) {
+        return false;
+    }
+
+    const uint16_t crc = buffer[written - 2] | buffer[written - 1] << 8;
+
+    return BinaryFrame::crc16(buffer, written - BINARY_FRAME_CRC) == crc;
+}
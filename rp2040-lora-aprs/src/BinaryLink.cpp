@@ -0,0 +1,167 @@
+#include "BinaryLink.h"
+#include "Logging.h"
+#include "System.h"
+
+BinaryLink::BinaryLink(System *system) : system(system) {
+}
+
+bool BinaryLink::isEnabled() const {
+    return system->settings.linux.binaryEnabled;
+}
+
+uint8_t BinaryLink::getErrors() const {
+    uint8_t errors = 0;
+
+    if (system->communication.hasError()) {
+        errors |= BinaryErrorLoRa;
+    }
+
+    if (system->energyThread->hasError()) {
+        errors |= BinaryErrorEnergy;
+    }
+
+    if (system->weatherThread->hasError()) {
+        errors |= BinaryErrorWeather;
+    }
+
+    return errors;
+}
+
+void BinaryLink::loop() {
+    if (!isEnabled()) {
+        return;
+    }
+
+    if (const uint8_t errors = getErrors(); errors != lastErrors) {
+        lastErrors = errors;
+        send(BinaryError, &errors, sizeof(errors));
+    }
+
+    if (timerStatus.hasExpired()) {
+        sendStatus();
+        timerStatus.restart();
+    }
+}
+
+void BinaryLink::sendStatus() {
+    const Communication &communication = system->communication;
+    const EnergyThread *energy = system->energyThread;
+    const WeatherThread *weather = system->weatherThread;
+    const bool hasWeather = weather->enabled && !weather->hasError();
+
+    BinaryStatusPayload status{};
+    status.uptime = millis() / 1000;
+    status.time = system->getDateTime().unixtime();
+    status.errors = getErrors();
+    status.loadSheddingTier = system->loadSheddingThread->getTier();
+    status.txQueueDepth = communication.txQueue.depth();
+    status.airtimeLastHour = communication.airtime.lastHour();
+    status.airtimeTotal = static_cast<uint32_t>(communication.airtime.getTotal() / 1000);
+    status.dutyCycle = communication.airtime.dutyCyclePerMille();
+    status.framesSent = communication.txQueue.stats.sent;
+    status.dupeHits = communication.dupeCache.hits;
+
+    for (const uint32_t dropped : communication.txQueue.stats.dropped) {
+        status.framesDropped += dropped;
+    }
+
+    if (system->ldrBoxOpenedThread->enabled && system->ldrBoxOpenedThread->isBoxOpened()) {
+        status.flags |= BinaryBoxOpened;
+    }
+
+    if (communication.digipeatOnlyDirect.load(std::memory_order_relaxed)) {
+        status.flags |= BinaryDigipeatOnlyDirect;
+    }
+
+    if (system->settings.energy.lightSleep) {
+        status.flags |= BinaryLightSleep;
+    }
+
+    if (!energy->hasError()) {
+        status.voltageBattery = energy->getVoltageBattery();
+        status.currentBattery = energy->getCurrentBattery();
+        status.voltageSolar = energy->getVoltageSolar();
+        status.currentSolar = energy->getCurrentSolar();
+    }
+
+    if (system->settings.rtc.enabled) {
+        status.temperatureRtc = static_cast<int16_t>(system->rtc.getTemperature() * 100);
+    }
+
+    int16_t temperatureBattery = 0;
+
+    if (system->settings.energy.type == mpptchg && !energy->hasError() && system->mpptChgCharger.getIndexedValue(VAL_INT_TEMP, &temperatureBattery)) {
+        status.temperatureBattery = static_cast<int16_t>(temperatureBattery * 10);
+    }
+
+    if (hasWeather) {
+        status.temperature = static_cast<int16_t>(weather->getTemperature() * 100);
+        status.humidity = static_cast<uint16_t>(weather->getHumidity() * 100);
+        status.pressure = static_cast<uint32_t>(weather->getPressure() * 100);
+    }
+
+    status.consumedLastDay = system->energyBudget.lastDayConsumed();
+    status.harvestedLastDay = system->energyBudget.lastDayHarvested();
+    status.stations = system->aprsHeard.size();
+    status.radioCoreLoops = system->getRadioCoreLoops();
+
+    send(BinaryStatus, &status, sizeof(status));
+}
+
+void BinaryLink::sendStations(const uint32_t since) {
+    // Most recently heard first, as in the JSON
+    for (auto station = system->aprsHeard.first(); station != nullptr && station->time >= since && strlen(system->aprsHeard.getPacket(station)) > 0; station = system->aprsHeard.next(station)) {
+        sendStation(BinaryStation, station);
+    }
+}
+
+void BinaryLink::heard(const AprsHeard *station) {
+    if (isEnabled() && station != nullptr) {
+        sendStation(BinaryHeard, station);
+    }
+}
+
+void BinaryLink::watchdogFired(const char *name) {
+    if (isEnabled()) {
+        send(BinaryWatchdogFired, name, strlen(name));
+    }
+}
+
+void BinaryLink::sendStation(const BinaryMessageType type, const AprsHeard *station) {
+    uint8_t payload[BINARY_FRAME_PAYLOAD_MAX];
+    auto *header = reinterpret_cast<BinaryStationPayload *>(payload);
+
+    memset(header, 0, sizeof(BinaryStationPayload));
+    header->time = station->time;
+    header->count = station->count;
+    header->snr = static_cast<int16_t>(station->snr * 100);
+    header->rssi = static_cast<int16_t>(station->rssi * 100);
+    header->digipeaterCount = station->digipeaterCount;
+    strncpy(header->callsign, station->callsign, BINARY_CALLSIGN_LENGTH);
+    strncpy(header->digipeaterCallsign, station->digipeaterCallsign, BINARY_CALLSIGN_LENGTH);
+
+    const char *packet = system->aprsHeard.getPacket(station);
+    size_t length = strlen(packet);
+
+    if (length > sizeof(payload) - sizeof(BinaryStationPayload)) {
+        length = sizeof(payload) - sizeof(BinaryStationPayload);
+    }
+
+    memcpy(payload + sizeof(BinaryStationPayload), packet, length);
+
+    send(type, payload, sizeof(BinaryStationPayload) + length);
+}
+
+bool BinaryLink::send(const BinaryMessageType type, const void *payload, const uint16_t length) {
+    const size_t size = BinaryFrame::encode(type, payload, length, buffer);
+
+    if (size == 0) {
+        Log.warningln(F("[BINARY] Payload of %d bytes too long"), length);
+        return false;
+    }
+
+    LOG_TRACE(F("[BINARY] Send type %d in %d bytes"), type, size);
+
+    // Not flushed: the UART FIFO drains while the loop goes on
+    return Serial1.write(buffer, size) == size;
+}
@@ -1,14 +1,18 @@
 #include <stdlib.h>
-#include "ArduinoLog.h"
+#include "Logging.h"
 
 #include "Command.h"
 #include "System.h"
 #include "utils.h"
 #include "Threads/Energy/EnergyMpptChgThread.h"
-#include "I2CSlave.h"
-#include "Threads/Energy/EnergyIna3221Thread.h"
+#include "SettingsRegistry.h"
 
 System* Command::system;
+Stream *Command::stream = nullptr;
+Settings *Command::imported = nullptr;
+Stream *Command::importStream = nullptr;
+uint32_t Command::lastImportLine = 0;
+uint16_t Command::importErrors = 0;
 
 Command::Command(System *system) {
     Command::system = system;
@@ -21,16 +25,22 @@ Command::Command(System *system) {
     parser.registerCommand(PSTR("reboot"), PSTR(""), doReboot);
     parser.registerCommand(PSTR("dfu"), PSTR(""), doDfu);
     parser.registerCommand(PSTR("json"), PSTR(""), doPrintJson);
+    parser.registerCommand(PSTR("jsonPart"), PSTR("s"), doPrintJsonPart);
+    parser.registerCommand(PSTR("jsonSince"), PSTR("su"), doPrintJsonSince);
+    parser.registerCommand(PSTR("binary"), PSTR("u"), doBinary);
     parser.registerCommand(PSTR("ping"), PSTR(""), doPing);
     parser.registerCommand(PSTR("gpio"), PSTR("su"), doGpioOutput);
     parser.registerCommand(PSTR("set"), PSTR("ss"), doSetSetting);
     parser.registerCommand(PSTR("get"), PSTR("s"), doGetSetting);
+    parser.registerCommand(PSTR("config"), PSTR("s"), doConfig);
     parser.registerCommand(PSTR("mpptDog"), PSTR("u"), doMpptWatchdog);
     parser.registerCommand(PSTR("objMsh"), PSTR(""), doMeshtasticAprs);
     parser.registerCommand(PSTR("objLinux"), PSTR(""), doLinuxAprs);
     parser.registerCommand(PSTR("box"), PSTR(""), doGetBoxInfo);
     parser.registerCommand(PSTR("error"), PSTR(""), doGetError);
     parser.registerCommand(PSTR("setLoraMode"), PSTR("duuuu"), doSetLora);
+    parser.registerCommand(PSTR("loraProfile"), PSTR("s"), doLoraProfile);
+    parser.registerCommand(PSTR("stats"), PSTR(""), doStats);
 
     parser.registerCommand(PSTR("?APRS?"), PSTR(""), doAprsQueryHelp);
     parser.registerCommand(PSTR("?APRSP"), PSTR(""), doPosition);
@@ -42,14 +52,30 @@ Command::Command(System *system) {
 }
 
 bool Command::processCommand(Stream* stream, const char *command) {
+    if (imported != nullptr && millis() - lastImportLine > TIME_CONFIG_IMPORT) {
+        Log.warningln(F("[CONFIG_IMPORT] No line for %ds, import dropped"), TIME_CONFIG_IMPORT / 1000);
+        endImport();
+    }
+
+    // Inside the import only the lines starting with a setting key are imported, the other commands on the same
+    // stream, as the periodic json of the Linux board, are run as usual
+    const bool isImporting = imported != nullptr && stream == importStream;
+
+    if (isImporting && SettingsRegistry::find(command, strcspn(command, " \r")) != nullptr) {
+        importLine(const_cast<char *>(command));
+        return true;
+    }
+
     if (strlen(command) < 3) {
-        Log.traceln(F("[COMMAND] Command received length %d : %s"), strlen(command), command);
+        LOG_TRACE(F("[COMMAND] Command received length %d : %s"), strlen(command), command);
         return false;
     }
 
     system->gpioLed.setState(true);
 
-    Log.traceln(F("[COMMAND] Process : %s"), command);
+    LOG_TRACE(F("[COMMAND] Process : %s"), command);
+
+    Command::stream = stream;
 
     if (!parser.processCommand(command, response)) {
         if (stream != nullptr) {
@@ -59,6 +85,12 @@ bool Command::processCommand(Stream* stream, const char *command) {
 
         Log.warningln(F("[COMMAND] %s KO (%s)"), command, response);
 
+        // Likely a setting with a wrong key, the commit is refused
+        if (isImporting && imported != nullptr) {
+            importErrors++;
+            Log.warningln(F("[CONFIG_IMPORT] Line %s is neither a setting nor a command"), command);
+        }
+
         ledBlink(2, 500);
 
         return false;
@@ -178,252 +210,18 @@ void Command::doSetSetting(MyCommandParser::Argument *args, char *response) {
     } else if (strcmp_P(key, PSTR("reset")) == 0) {
         ok = system->resetSettings();
         shouldReboot = ok;
-    } else if (strcmp_P(key, PSTR("lora.frequency")) == 0) {
-        system->settings.lora.frequency = strtof(value, nullptr);
-        ok = system->communication.begin();
-    } else if (strcmp_P(key, PSTR("lora.bandwidth")) == 0) {
-        system->settings.lora.bandwidth = static_cast<uint16_t>(strtoul(value, nullptr, 0));
-        ok = system->communication.begin();
-    } else if (strcmp_P(key, PSTR("lora.spreadingFactor")) == 0) {
-        system->settings.lora.spreadingFactor = static_cast<uint8_t>(strtoul(value, nullptr, 0));
-        ok = system->communication.begin();
-    } else if (strcmp_P(key, PSTR("lora.codingRate")) == 0) {
-        system->settings.lora.codingRate = static_cast<uint8_t>(strtoul(value, nullptr, 0));
-        ok = system->communication.begin();
-    } else if (strcmp_P(key, PSTR("lora.outputPower")) == 0) {
-        system->settings.lora.outputPower = static_cast<uint8_t>(strtoul(value, nullptr, 0));
-        ok = system->communication.begin();
-    } else if (strcmp_P(key, PSTR("lora.txEnabled")) == 0) {
-        system->settings.lora.txEnabled = value[0] == '1';
-        system->watchdogSlaveLoraTxThread->feed();
-    } else if (strcmp_P(key, PSTR("lora.watchdogTxEnabled")) == 0) {
-        system->settings.lora.watchdogTxEnabled =
-                system->watchdogSlaveLoraTxThread->enabled = value[0] == '1';
-    } else if (strcmp_P(key, PSTR("lora.intervalTimeoutWatchdogTx")) == 0) {
-        system->settings.lora.intervalTimeoutWatchdogTx = strtoull(value, nullptr, 0);
-        system->watchdogSlaveLoraTxThread->setInterval(system->settings.lora.intervalTimeoutWatchdogTx);
-    } else if (strcmp_P(key, PSTR("aprs.call")) == 0) {
-        strcpy(system->settings.aprs.call, value);
-    } else if (strcmp_P(key, PSTR("aprs.destination")) == 0) {
-        strcpy(system->settings.aprs.destination, value);
-    } else if (strcmp_P(key, PSTR("aprs.path")) == 0) {
-        strcpy(system->settings.aprs.path, value);
-    } else if (strcmp_P(key, PSTR("aprs.comment")) == 0) {
-        strcpy(system->settings.aprs.comment, value);
-    } else if (strcmp_P(key, PSTR("aprs.status")) == 0) {
-        strcpy(system->settings.aprs.status, value);
-    } else if (strcmp_P(key, PSTR("aprs.symbol")) == 0) {
-        system->settings.aprs.symbol = value[0];
-    } else if (strcmp_P(key, PSTR("aprs.symbolTable")) == 0) {
-        system->settings.aprs.symbolTable = value[0];
-    } else if (strcmp_P(key, PSTR("aprs.latitude")) == 0) {
-        system->settings.aprs.latitude = strtod(value, nullptr);
-    } else if (strcmp_P(key, PSTR("aprs.longitude")) == 0) {
-        system->settings.aprs.longitude = strtod(value, nullptr);
-    } else if (strcmp_P(key, PSTR("aprs.altitude")) == 0) {
-        system->settings.aprs.altitude = static_cast<uint16_t>(strtoul(value, nullptr, 0));
-    } else if (strcmp_P(key, PSTR("aprs.digipeaterEnabled")) == 0) {
-        system->settings.aprs.digipeaterEnabled = value[0] == '1';
-    } else if (strcmp_P(key, PSTR("aprs.telemetryEnabled")) == 0) {
-        system->settings.aprs.telemetryEnabled =
-                system->sendTelemetriesThread->enabled = value[0] == '1';
-    } else if (strcmp_P(key, PSTR("aprs.intervalTelemetry")) == 0) {
-        system->settings.aprs.intervalTelemetry = strtoull(value, nullptr, 0);
-        system->sendTelemetriesThread->setInterval(system->settings.aprs.intervalTelemetry);
-    } else if (strcmp_P(key, PSTR("aprs.statusEnabled")) == 0) {
-        system->settings.aprs.statusEnabled =
-                system->sendStatusThread->enabled = value[0] == '1';
-    } else if (strcmp_P(key, PSTR("aprs.intervalStatus")) == 0) {
-        system->settings.aprs.intervalStatus = strtoull(value, nullptr, 0);
-        system->sendStatusThread->setInterval(system->settings.aprs.intervalStatus);
-    } else if (strcmp_P(key, PSTR("aprs.positionWeatherEnabled")) == 0) {
-        system->settings.aprs.positionWeatherEnabled =
-                system->sendPositionThread->enabled = value[0] == '1';
-    } else if (strcmp_P(key, PSTR("aprs.intervalPositionWeather")) == 0) {
-        system->settings.aprs.intervalPositionWeather = strtoull(value, nullptr, 0);
-        system->sendPositionThread->setInterval(system->settings.aprs.intervalPositionWeather);
-    } else if (strcmp_P(key, PSTR("aprs.telemetryInPosition")) == 0) {
-        system->settings.aprs.telemetryInPosition = value[0] == '1';
-    } else if (strcmp_P(key, PSTR("aprs.telemetrySequenceNumber")) == 0) {
-        system->settings.aprs.telemetrySequenceNumber = static_cast<uint16_t>(strtoul(value, nullptr, 0));
-    } else if (strcmp_P(key, PSTR("meshtastic.watchdogEnabled")) == 0) {
-        system->settings.meshtastic.watchdogEnabled =
-                system->watchdogMeshtastic->enabled = value[0] == '1';
-        if (system->watchdogMeshtastic->enabled) {
-            system->watchdogMeshtastic->feed();
-        }
-    } else if (strcmp_P(key, PSTR("meshtastic.intervalTimeoutWatchdog")) == 0) {
-        system->settings.meshtastic.intervalTimeoutWatchdog = strtoull(value, nullptr, 0);
-        system->watchdogMeshtastic->setInterval(system->settings.meshtastic.intervalTimeoutWatchdog);
-    } else if (strcmp_P(key, PSTR("meshtastic.pin")) == 0) {
-        system->settings.meshtastic.pin = static_cast<uint8_t>(strtoul(value, nullptr, 0));
-        if (system->watchdogMeshtastic->enabled) {
-            system->planReboot();
-            shouldReboot = true;
-        }
-    } else if (strcmp_P(key, PSTR("meshtastic.i2cSlaveEnabled")) == 0) {
-        system->settings.meshtastic.i2cSlaveEnabled = value[0] == '1';
-        if (system->settings.meshtastic.i2cSlaveEnabled) {
-            I2CSlave::begin(system);
-        } else {
-            I2CSlave::end();
-        }
-    } else if (strcmp_P(key, PSTR("meshtastic.i2cSlaveAddress")) == 0) {
-        system->settings.meshtastic.i2cSlaveAddress = static_cast<uint8_t>(strtoul(value, nullptr, 0));
-        if (system->settings.meshtastic.i2cSlaveEnabled) {
-            I2CSlave::end();
-            I2CSlave::begin(system);
-        }
-    } else if (strcmp_P(key, PSTR("meshtastic.aprsSendItemEnabled")) == 0) {
-        system->settings.meshtastic.aprsSendItemEnabled =
-        system->sendMeshtasticAprsThread->enabled = value[0] == '1';
-    } else if (strcmp_P(key, PSTR("meshtastic.intervalSendItem")) == 0) {
-        system->settings.meshtastic.intervalSendItem = strtoull(value, nullptr, 0);
-        system->sendMeshtasticAprsThread->setInterval(system->settings.meshtastic.intervalSendItem);
-    } else if (strcmp_P(key, PSTR("meshtastic.itemName")) == 0) {
-        strcpy(system->settings.meshtastic.itemName, value);
-    } else if (strcmp_P(key, PSTR("meshtastic.itemComment")) == 0) {
-        strcpy(system->settings.meshtastic.itemComment, value);
-    } else if (strcmp_P(key, PSTR("meshtastic.symbol")) == 0) {
-        system->settings.meshtastic.symbol = value[0];
-    } else if (strcmp_P(key, PSTR("meshtastic.symbolTable")) == 0) {
-        system->settings.meshtastic.symbolTable = value[0];
-    } else if (strcmp_P(key, PSTR("meshtastic.latitude")) == 0) {
-        system->settings.meshtastic.latitude = strtod(value, nullptr);
-    } else if (strcmp_P(key, PSTR("meshtastic.longitude")) == 0) {
-        system->settings.meshtastic.longitude = strtod(value, nullptr);
-    } else if (strcmp_P(key, PSTR("meshtastic.altitude")) == 0) {
-        system->settings.meshtastic.altitude = static_cast<uint16_t>(strtoul(value, nullptr, 0));
-    } else if (strcmp_P(key, PSTR("mpptWatchdog.enabled")) == 0) {
-        system->settings.mpptWatchdog.enabled = value[0] == '1';
-        if (system->watchdogSlaveMpptChgThread->enabled) {
-            system->watchdogSlaveMpptChgThread->feed();
-        }
-    } else if (strcmp_P(key, PSTR("mpptWatchdog.timeout")) == 0) {
-        system->settings.mpptWatchdog.timeout = strtoull(value, nullptr, 0);
-        if (system->settings.mpptWatchdog.enabled) {
-            system->watchdogSlaveMpptChgThread->feed(); // Set timeout with feed
-        }
-    } else if (strcmp_P(key, PSTR("mpptWatchdog.intervalFeed")) == 0) {
-        system->settings.mpptWatchdog.intervalFeed = strtoull(value, nullptr, 0);
-        system->watchdogSlaveMpptChgThread->setInterval(system->settings.mpptWatchdog.intervalFeed);
-    } else if (strcmp_P(key, PSTR("mpptWatchdog.timeOff")) == 0) {
-        system->settings.mpptWatchdog.timeOff = static_cast<uint16_t>(strtoul(value, nullptr, 0));
-        if (system->settings.mpptWatchdog.enabled) {
-            system->watchdogSlaveMpptChgThread->feed();
-        }
-    } else if (strcmp_P(key, PSTR("boxOpened.enabled")) == 0) {
-        system->settings.boxOpened.enabled = value[0] == '1';
-    } else if (strcmp_P(key, PSTR("boxOpened.intervalCheck")) == 0) {
-        system->settings.boxOpened.intervalCheck = strtoull(value, nullptr, 0);
-        system->ldrBoxOpenedThread->setInterval(system->settings.boxOpened.intervalCheck);
-    } else if (strcmp_P(key, PSTR("boxOpened.pin")) == 0) {
-        system->settings.boxOpened.pin = static_cast<uint8_t>(strtoul(value, nullptr, 0));
-        if (system->settings.boxOpened.enabled) {
-            system->planReboot();
-            shouldReboot = true;
-        }
-    } else if (strcmp_P(key, PSTR("weather.enabled")) == 0) {
-        system->settings.weather.enabled = value[0] == '1';
-    } else if (strcmp_P(key, PSTR("weather.intervalCheck")) == 0) {
-        system->settings.weather.intervalCheck = strtoull(value, nullptr, 0);
-        system->weatherThread->setInterval(system->settings.weather.intervalCheck);
-    } else if (strcmp_P(key, PSTR("energy.intervalCheck")) == 0) {
-        system->settings.energy.intervalCheck = strtoull(value, nullptr, 0);
-        system->energyThread->setInterval(system->settings.energy.intervalCheck);
-    } else if (strcmp_P(key, PSTR("energy.type")) == 0) {
-        system->settings.energy.type = static_cast<TypeEnergySensor>(strtoul(value, nullptr, 0));
-        system->planReboot();
-        shouldReboot = true;
-    } else if (strcmp_P(key, PSTR("energy.adcPin")) == 0) {
-        system->settings.energy.adcPin = static_cast<uint8_t>(strtoul(value, nullptr, 0));
-        system->planReboot();
-        shouldReboot = true;
-    } else if (strcmp_P(key, PSTR("energy.inaChannelBattery")) == 0) {
-        system->settings.energy.inaChannelBattery =
-                static_cast<EnergyIna3221Thread *>(system->energyThread)->channelBattery = static_cast<ina3221_ch_t>(strtoul(value, nullptr, 0));
-    } else if (strcmp_P(key, PSTR("energy.inaChannelSolar")) == 0) {
-        system->settings.energy.inaChannelSolar =
-                static_cast<EnergyIna3221Thread *>(system->energyThread)->channelSolar = static_cast<ina3221_ch_t>(strtoul(value, nullptr, 0));
-    } else if (strcmp_P(key, PSTR("energy.mpptPowerOnVoltage")) == 0) {
-        system->settings.energy.mpptPowerOnVoltage = static_cast<uint16_t>(strtoul(value, nullptr, 0));
-        ok = system->energyThread->begin();
-    } else if (strcmp_P(key, PSTR("energy.mpptPowerOffVoltage")) == 0) {
-        system->settings.energy.mpptPowerOffVoltage = static_cast<uint16_t>(strtoul(value, nullptr, 0));
-        ok = system->energyThread->begin();
-    } else if (strcmp_P(key, PSTR("linux.watchdogEnabled")) == 0) {
-        system->settings.linux.watchdogEnabled =
-            system->watchdogLinux->enabled = value[0] == '1';
-        if (system->watchdogLinux->enabled) {
-            system->watchdogMeshtastic->feed();
-        }
-    } else if (strcmp_P(key, PSTR("linux.intervalTimeoutWatchdog")) == 0) {
-        system->settings.linux.intervalTimeoutWatchdog = strtoull(value, nullptr, 0);
-        system->watchdogLinux->setInterval(system->settings.linux.intervalTimeoutWatchdog);
-    } else if (strcmp_P(key, PSTR("linux.pin")) == 0) {
-        system->settings.linux.pin = static_cast<uint8_t>(strtoul(value, nullptr, 0));
-        if (system->watchdogLinux->enabled) {
-            system->planReboot();
-            shouldReboot = true;
-        }
-    } else if (strcmp_P(key, PSTR("linux.nprPin")) == 0) {
-        system->settings.linux.nprPin = static_cast<uint8_t>(strtoul(value, nullptr, 0));
-        system->planReboot();
-        shouldReboot = true;
-    } else if (strcmp_P(key, PSTR("linux.wifiPin")) == 0) {
-        system->settings.linux.wifiPin = static_cast<uint8_t>(strtoul(value, nullptr, 0));
-        system->planReboot();
-        shouldReboot = true;
-    } else if (strcmp_P(key, PSTR("linux.aprsSendItemEnabled")) == 0) {
-        system->settings.linux.aprsSendItemEnabled =
-        system->sendLinuxAprsThread->enabled = value[0] == '1';
-    } else if (strcmp_P(key, PSTR("linux.intervalSendItem")) == 0) {
-        system->settings.linux.intervalSendItem = strtoull(value, nullptr, 0);
-        system->sendLinuxAprsThread->setInterval(system->settings.linux.intervalSendItem);
-    } else if (strcmp_P(key, PSTR("linux.itemName")) == 0) {
-        strcpy(system->settings.linux.itemName, value);
-    } else if (strcmp_P(key, PSTR("linux.itemComment")) == 0) {
-        strcpy(system->settings.linux.itemComment, value);
-    } else if (strcmp_P(key, PSTR("linux.symbol")) == 0) {
-        system->settings.linux.symbol = value[0];
-    } else if (strcmp_P(key, PSTR("linux.symbolTable")) == 0) {
-        system->settings.linux.symbolTable = value[0];
-    } else if (strcmp_P(key, PSTR("linux.latitude")) == 0) {
-        system->settings.linux.latitude = strtod(value, nullptr);
-    } else if (strcmp_P(key, PSTR("linux.longitude")) == 0) {
-        system->settings.linux.longitude = strtod(value, nullptr);
-    } else if (strcmp_P(key, PSTR("linux.altitude")) == 0) {
-        system->settings.linux.altitude = static_cast<uint16_t>(strtoul(value, nullptr, 0));
-    } else if (strcmp_P(key, PSTR("rtc.enabled")) == 0) {
-        system->settings.rtc.enabled = value[0] == '1';
-    } else if (strcmp_P(key, PSTR("rtc.wakeUpPin")) == 0) {
-        system->settings.rtc.wakeUpPin = static_cast<uint8_t>(strtoul(value, nullptr, 0));
-        if (system->settings.rtc.enabled) {
-            system->planReboot();
-            shouldReboot = true;
-        }
-    } else if (strcmp_P(key, PSTR("useInternalWatchdog")) == 0) {
-        system->settings.useInternalWatchdog = value[0] == '1';
-        system->planReboot();
-        shouldReboot = true;
-    } else if (strcmp_P(key, PSTR("useSlowClock")) == 0) {
-        system->settings.useSlowClock = value[0] == '1';
-        system->planReboot();
-        shouldReboot = true;
     } else if (strcmp_P(key, PSTR("aprsReceived")) == 0) {
-        for (auto &[callsign, time, rssi, snr, content, count, digipeaterCallsign, digipeaterCount, reserved] : system->settings.aprsCallsignsHeard) {
-            callsign[0] = '\0';
-            content[0] = '\0';
-            time = 0;
-            rssi = 0;
-            snr = 0;
-            count = 0;
-            digipeaterCount = 0;
-            digipeaterCallsign[0] = '\0';
-        }
-    } else {
+        system->aprsHeard.clear();
+    } else if (const SettingDescriptor *setting = SettingsRegistry::find(key); setting == nullptr) {
         Log.warningln(F("[COMMAND] Config key not found"));
         ok = false;
+    } else if (!SettingsRegistry::set(system, setting, value)) {
+        Log.warningln(F("[COMMAND] Value %s not valid for %s"), value, key);
+        ok = false;
+    } else if (setting->apply != nullptr) {
+        const SettingApply applied = setting->apply(system);
+        ok = applied != SettingNotApplied;
+        shouldReboot = applied == SettingNeedsReboot;
     }
 
     if (ok) {
@@ -448,151 +246,15 @@ void Command::doSetSetting(MyCommandParser::Argument *args, char *response) {
 void Command::doGetSetting(MyCommandParser::Argument *args, char *response) {
     const char *key = args[0].asString;
 
-    if (strcmp_P(key, PSTR("lora.frequency")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%f"), system->settings.lora.frequency);
-    } else if (strcmp_P(key, PSTR("lora.bandwidth")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.lora.bandwidth);
-    } else if (strcmp_P(key, PSTR("lora.spreadingFactor")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.lora.spreadingFactor);
-    } else if (strcmp_P(key, PSTR("lora.codingRate")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.lora.codingRate);
-    } else if (strcmp_P(key, PSTR("lora.outputPower")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.lora.outputPower);
-    } else if (strcmp_P(key, PSTR("lora.txEnabled")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.lora.txEnabled);
-    } else if (strcmp_P(key, PSTR("lora.watchdogTxEnabled")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.lora.watchdogTxEnabled);
-    } else if (strcmp_P(key, PSTR("lora.intervalTimeoutWatchdogTx")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%llu"), system->settings.lora.intervalTimeoutWatchdogTx);
-    } else if (strcmp_P(key, PSTR("aprs.call")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s"), system->settings.aprs.call);
-    } else if (strcmp_P(key, PSTR("aprs.destination")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s"), system->settings.aprs.destination);
-    } else if (strcmp_P(key, PSTR("aprs.path")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s"), system->settings.aprs.path);
-    } else if (strcmp_P(key, PSTR("aprs.comment")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s"), system->settings.aprs.comment);
-    } else if (strcmp_P(key, PSTR("aprs.status")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s"), system->settings.aprs.status);
-    } else if (strcmp_P(key, PSTR("aprs.symbol")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%c"), system->settings.aprs.symbol);
-    } else if (strcmp_P(key, PSTR("aprs.symbolTable")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%c"), system->settings.aprs.symbolTable);
-    } else if (strcmp_P(key, PSTR("aprs.latitude")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%lf"), system->settings.aprs.latitude);
-    } else if (strcmp_P(key, PSTR("aprs.longitude")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%lf"), system->settings.aprs.longitude);
-    } else if (strcmp_P(key, PSTR("aprs.altitude")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.aprs.altitude);
-    } else if (strcmp_P(key, PSTR("aprs.digipeaterEnabled")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.aprs.digipeaterEnabled);
-    } else if (strcmp_P(key, PSTR("aprs.telemetryEnabled")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.aprs.telemetryEnabled);
-    } else if (strcmp_P(key, PSTR("aprs.intervalTelemetry")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%llu"), system->settings.aprs.intervalTelemetry);
-    } else if (strcmp_P(key, PSTR("aprs.statusEnabled")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.aprs.statusEnabled);
-    } else if (strcmp_P(key, PSTR("aprs.intervalStatus")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%llu"), system->settings.aprs.intervalStatus);
-    } else if (strcmp_P(key, PSTR("aprs.positionWeatherEnabled")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.aprs.positionWeatherEnabled);
-    } else if (strcmp_P(key, PSTR("aprs.intervalPositionWeather")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%llu"), system->settings.aprs.intervalPositionWeather);
-    } else if (strcmp_P(key, PSTR("aprs.telemetryInPosition")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.aprs.telemetryInPosition);
-    } else if (strcmp_P(key, PSTR("aprs.telemetrySequenceNumber")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.aprs.telemetrySequenceNumber);
-    } else if (strcmp_P(key, PSTR("meshtastic.watchdogEnabled")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.meshtastic.watchdogEnabled);
-    } else if (strcmp_P(key, PSTR("meshtastic.intervalTimeoutWatchdog")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%llu"), system->settings.meshtastic.intervalTimeoutWatchdog);
-    } else if (strcmp_P(key, PSTR("meshtastic.pin")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.meshtastic.pin);
-    } else if (strcmp_P(key, PSTR("meshtastic.i2cSlaveEnabled")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.meshtastic.i2cSlaveEnabled);
-    } else if (strcmp_P(key, PSTR("meshtastic.i2cSlaveAddress")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("0x%x"), system->settings.meshtastic.i2cSlaveAddress);
-    } else if (strcmp_P(key, PSTR("meshtastic.aprsSendItemEnabled")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.meshtastic.aprsSendItemEnabled);
-    } else if (strcmp_P(key, PSTR("meshtastic.intervalSendItem")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%llu"), system->settings.meshtastic.intervalSendItem);
-    } else if (strcmp_P(key, PSTR("meshtastic.itemName")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s"), system->settings.meshtastic.itemName);
-    } else if (strcmp_P(key, PSTR("meshtastic.itemComment")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s"), system->settings.meshtastic.itemComment);
-    } else if (strcmp_P(key, PSTR("meshtastic.latitude")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%lf"), system->settings.meshtastic.latitude);
-    } else if (strcmp_P(key, PSTR("meshtastic.longitude")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%lf"), system->settings.meshtastic.longitude);
-    } else if (strcmp_P(key, PSTR("meshtastic.altitude")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.meshtastic.altitude);
-    } else if (strcmp_P(key, PSTR("mpptWatchdog.enabled")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.mpptWatchdog.enabled);
-    } else if (strcmp_P(key, PSTR("mpptWatchdog.timeout")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%llu"), system->settings.mpptWatchdog.timeout);
-    } else if (strcmp_P(key, PSTR("mpptWatchdog.intervalFeed")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%llu"), system->settings.mpptWatchdog.intervalFeed);
-    } else if (strcmp_P(key, PSTR("mpptWatchdog.timeOff")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.mpptWatchdog.timeOff);
-    } else if (strcmp_P(key, PSTR("boxOpened.enabled")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.boxOpened.enabled);
-    } else if (strcmp_P(key, PSTR("boxOpened.intervalCheck")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%llu"), system->settings.boxOpened.intervalCheck);
-    } else if (strcmp_P(key, PSTR("boxOpened.pin")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.boxOpened.pin);
-    } else if (strcmp_P(key, PSTR("weather.enabled")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.weather.enabled);
-    } else if (strcmp_P(key, PSTR("weather.intervalCheck")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%llu"), system->settings.weather.intervalCheck);
-    } else if (strcmp_P(key, PSTR("energy.intervalCheck")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%llu"), system->settings.energy.intervalCheck);
-    } else if (strcmp_P(key, PSTR("energy.type")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.energy.type);
-    } else if (strcmp_P(key, PSTR("energy.adcPin")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.energy.adcPin);
-    } else if (strcmp_P(key, PSTR("energy.inaChannelBattery")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.energy.inaChannelBattery);
-    } else if (strcmp_P(key, PSTR("energy.inaChannelSolar")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.energy.inaChannelSolar);
-    } else if (strcmp_P(key, PSTR("energy.mpptPowerOnVoltage")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.energy.mpptPowerOnVoltage);
-    } else if (strcmp_P(key, PSTR("energy.mpptPowerOffVoltage")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.energy.mpptPowerOffVoltage);
-    } else if (strcmp_P(key, PSTR("linux.watchdogEnabled")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.linux.watchdogEnabled);
-    } else if (strcmp_P(key, PSTR("linux.intervalTimeoutWatchdog")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%llu"), system->settings.linux.intervalTimeoutWatchdog);
-    } else if (strcmp_P(key, PSTR("linux.pin")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.linux.pin);
-    } else if (strcmp_P(key, PSTR("linux.nprPin")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.linux.nprPin);
-    } else if (strcmp_P(key, PSTR("linux.wifiPin")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.linux.wifiPin);
-    } else if (strcmp_P(key, PSTR("linux.aprsSendItemEnabled")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.linux.aprsSendItemEnabled);
-    } else if (strcmp_P(key, PSTR("linux.intervalSendItem")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%llu"), system->settings.linux.intervalSendItem);
-    } else if (strcmp_P(key, PSTR("linux.itemName")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s"), system->settings.linux.itemName);
-    } else if (strcmp_P(key, PSTR("linux.itemComment")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s"), system->settings.linux.itemComment);
-    } else if (strcmp_P(key, PSTR("linux.latitude")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%lf"), system->settings.linux.latitude);
-    } else if (strcmp_P(key, PSTR("linux.longitude")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%lf"), system->settings.linux.longitude);
-    } else if (strcmp_P(key, PSTR("linux.altitude")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.linux.altitude);
-    } else if (strcmp_P(key, PSTR("rtc.enabled")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.rtc.enabled);
-    } else if (strcmp_P(key, PSTR("rtc.wakeUpPin")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.rtc.wakeUpPin);
-    } else if (strcmp_P(key, PSTR("useInternalWatchdog")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.useInternalWatchdog);
-    } else if (strcmp_P(key, PSTR("useSlowClock")) == 0) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%d"), system->settings.useSlowClock);
+    if (const SettingDescriptor *setting = SettingsRegistry::find(key); setting != nullptr) {
+        SettingsRegistry::format(setting, &system->settings, response, MyCommandParser::MAX_RESPONSE_SIZE);
     } else if (strcmp_P(key, PSTR("all")) == 0) {
         system->printSettings();
         strncpy_P(response, PSTR("OK"), MyCommandParser::MAX_RESPONSE_SIZE);
+    } else if (strcmp_P(key, PSTR("json")) == 0) {
+        system->printSettingsJson(false);
+        system->printSettingsJson(true);
+        strncpy_P(response, PSTR(""), MyCommandParser::MAX_RESPONSE_SIZE);
     } else if (strcmp_P(key, PSTR("reset")) == 0) {
         // Ignored: case when set command with reset
     } else {
@@ -601,15 +263,134 @@ void Command::doGetSetting(MyCommandParser::Argument *args, char *response) {
     }
 }
 
+void Command::doConfig(MyCommandParser::Argument *args, char *response) {
+    char *action = args[0].asString;
+    action[strcspn(action, "\r")] = '\0'; // Export replayed from a file with CRLF
+
+    if (stream == nullptr) {
+        Log.warningln(F("[CONFIG_IMPORT] Only over a serial link"));
+        strncpy_P(response, PSTR("KO"), MyCommandParser::MAX_RESPONSE_SIZE);
+    } else if (strcmp_P(action, PSTR("export")) == 0) {
+        // Replayable as is: import, one line per setting, commit
+        stream->println(F("config import"));
+        SettingsRegistry::writeText(stream, &system->settings);
+        strncpy_P(response, PSTR("config commit"), MyCommandParser::MAX_RESPONSE_SIZE);
+    } else if (strcmp_P(action, PSTR("import")) == 0) {
+        endImport();
+
+        imported = new Settings(system->settings);
+        importStream = stream;
+        lastImportLine = millis();
+
+        Log.infoln(F("[CONFIG_IMPORT] Started, waiting lines until config commit"));
+        strncpy_P(response, PSTR("OK"), MyCommandParser::MAX_RESPONSE_SIZE);
+    } else if (strcmp_P(action, PSTR("commit")) == 0) {
+        commitImport(response);
+    } else if (strcmp_P(action, PSTR("abort")) == 0) {
+        endImport();
+        strncpy_P(response, PSTR("OK"), MyCommandParser::MAX_RESPONSE_SIZE);
+    } else {
+        strncpy_P(response, PSTR("KO"), MyCommandParser::MAX_RESPONSE_SIZE);
+    }
+}
+
+void Command::importLine(char *line) {
+    lastImportLine = millis();
+
+    if (strlen(line) == 0 || line[0] == '\r') {
+        return;
+    }
+
+    if (SettingsRegistry::parseLine(imported, line) == nullptr) {
+        importErrors++;
+        Log.warningln(F("[CONFIG_IMPORT] Line for %s not valid"), line);
+    }
+}
+
+void Command::commitImport(char *response) {
+    if (imported == nullptr || stream != importStream) {
+        Log.warningln(F("[CONFIG_IMPORT] No import to commit"));
+        strncpy_P(response, PSTR("KO"), MyCommandParser::MAX_RESPONSE_SIZE);
+        return;
+    }
+
+    if (importErrors > 0) {
+        Log.warningln(F("[CONFIG_IMPORT] %d lines not valid, nothing changed"), importErrors);
+        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("KO %d errors"), importErrors);
+        endImport();
+        return;
+    }
+
+    uint16_t changed = 0;
+    const SettingApply applied = SettingsRegistry::commit(system, imported, &changed);
+
+    endImport();
+
+    // Written once for the whole import, in a temporary file renamed over the old one
+    if (changed > 0 && !system->saveSettings()) {
+        strncpy_P(response, PSTR("KO"), MyCommandParser::MAX_RESPONSE_SIZE);
+        return;
+    }
+
+    Log.infoln(F("[CONFIG_IMPORT] %d settings changed"), changed);
+
+    snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s %d%s"),
+               applied == SettingNotApplied ? "KO" : "OK", changed, applied == SettingNeedsReboot ? " Reboot" : "");
+}
+
+void Command::endImport() {
+    delete imported;
+
+    imported = nullptr;
+    importStream = nullptr;
+    importErrors = 0;
+}
+
 void Command::doPrintJson(MyCommandParser::Argument *args, char *response) {
-    system->energyThread->run();
+    printJson(JsonAll, 0, response);
+}
+
+void Command::doPrintJsonPart(MyCommandParser::Argument *args, char *response) {
+    uint32_t sections;
+
+    if (!JsonSections::parse(args[0].asString, &sections)) {
+        strncpy_P(response, PSTR("KO"), MyCommandParser::MAX_RESPONSE_SIZE);
+        return;
+    }
+
+    printJson(sections, 0, response);
+}
+
+void Command::doPrintJsonSince(MyCommandParser::Argument *args, char *response) {
+    uint32_t sections;
+
+    if (!JsonSections::parse(args[0].asString, &sections)) {
+        strncpy_P(response, PSTR("KO"), MyCommandParser::MAX_RESPONSE_SIZE);
+        return;
+    }
+
+    printJson(sections, args[1].asUInt64, response);
+}
+
+void Command::doBinary(MyCommandParser::Argument *args, char *response) {
+    system->binaryLink.sendStatus();
+    system->binaryLink.sendStations(args[0].asUInt64);
+
+    strncpy_P(response, PSTR(""), MyCommandParser::MAX_RESPONSE_SIZE);
+}
+
+void Command::printJson(const uint32_t sections, const uint32_t since, char *response) {
+    // Fresh measures only when they are asked
+    if (sections & JsonEnergy) {
+        system->energyThread->run();
+    }
 
-    if (system->weatherThread->enabled) {
+    if (sections & JsonWeather && system->weatherThread->enabled) {
         system->weatherThread->run();
     }
 
-    system->printJson(false);
-    system->printJson(true);
+    system->printJson(false, sections, since);
+    system->printJson(true, sections, since);
 
     strncpy_P(response, PSTR(""), MyCommandParser::MAX_RESPONSE_SIZE);
 }
@@ -657,6 +438,17 @@ void Command::doGetError(MyCommandParser::Argument *args, char *response) {
     snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("Energy: %d | Weather: %d | LoRa : %d"), system->energyThread->hasError(), system->weatherThread->hasError(), system->communication.hasError());
 }
 
+void Command::doStats(MyCommandParser::Argument *args, char *response) {
+    system->printStats();
+
+    const auto slowest = system->getSlowestThread();
+
+    snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("Loop avg:%luus p99:%luus max:%luus jitter:%luus | Slowest %s max:%luus overruns:%lu"),
+        static_cast<unsigned long>(system->loopStats.getAverage()), static_cast<unsigned long>(system->loopStats.percentile(99)), static_cast<unsigned long>(system->loopStats.getMax()),
+        static_cast<unsigned long>(system->loopPeriodStats.getMax() - system->loopPeriodStats.getMin()),
+        slowest != nullptr ? slowest->ThreadName.c_str() : "-", static_cast<unsigned long>(slowest != nullptr ? slowest->stats.getMax() : 0), static_cast<unsigned long>(slowest != nullptr ? slowest->stats.getOverruns() : 0));
+}
+
 void Command::doSetLora(MyCommandParser::Argument *args, char *response) {
     const auto frequency = args[0].asDouble;
     const auto bandwidth = args[1].asUInt64;
@@ -669,6 +461,24 @@ void Command::doSetLora(MyCommandParser::Argument *args, char *response) {
     strncpy_P(response, ok ? PSTR("OK") : PSTR("KO"), MyCommandParser::MAX_RESPONSE_SIZE);
 }
 
+// Name of a profile to stay on it, or auto to follow the scheduler again
+void Command::doLoraProfile(MyCommandParser::Argument *args, char *response) {
+    const char *name = args[0].asString;
+    const SettingsLoRaScheduler &settings = system->settings.loraScheduler;
+    const bool isAuto = strcasecmp_P(name, PSTR("auto")) == 0;
+    const int8_t profile = isAuto ? LORA_PROFILE_AUTO : LoRaScheduler::find(name, settings);
+
+    if (!isAuto && profile == LORA_PROFILE_AUTO) {
+        strncpy_P(response, PSTR("KO unknown profile"), MyCommandParser::MAX_RESPONSE_SIZE);
+        return;
+    }
+
+    const bool ok = system->communication.holdLoRaProfile(profile);
+
+    snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s %s%s"), ok ? "OK" : "KO", LoRaScheduler::getName(system->communication.scheduler.getProfile(), settings),
+               isAuto ? " auto" : "");
+}
+
 void Command::doAprsQueryHelp(MyCommandParser::Argument *args, char *response) {
     strncpy_P(response, PSTR("?APRSP ?APRSD ?APRSL ?APRSH CALL ?APRSV ?PING"), MyCommandParser::MAX_RESPONSE_SIZE);
 }
@@ -679,19 +489,18 @@ void Command::doAprsHeardWithoutDigi(MyCommandParser::Argument *args, char *resp
     constexpr int hours = 2;
     constexpr int maxTime = 3600 * hours;
 
-    for (auto &[callsign, time, rssi, snr, content, count, digipeaterCallsign, digipeaterCount, reserved] : system->settings.aprsCallsignsHeard) {
+    // Most recent first, so stop at the first one too old
+    for (auto station = system->aprsHeard.first(); station != nullptr && now - station->time <= maxTime; station = system->aprsHeard.next(station)) {
         if (strlen(response) >= MyCommandParser::MAX_RESPONSE_SIZE - 10) {
             return;
         }
 
-        if (strlen(callsign) > 0 && strlen(content) > 0 && strlen(digipeaterCallsign) == 0 && digipeaterCount == 0) {
+        if (strlen(station->digipeaterCallsign) == 0 && station->digipeaterCount == 0) {
             if (strlen(response) > 0) {
                 strncat_P(response, PSTR(" "), MyCommandParser::MAX_RESPONSE_SIZE - strlen(response));
             }
 
-            if (now - time <= maxTime) {
-                strncat_P(response, callsign, MyCommandParser::MAX_RESPONSE_SIZE - strlen(response));
-            }
+            strncat(response, station->callsign, MyCommandParser::MAX_RESPONSE_SIZE - strlen(response));
         }
     }
 
@@ -706,20 +515,16 @@ void Command::doAprsHeard(MyCommandParser::Argument *args, char *response) {
     constexpr int hours = 2;
     constexpr int maxTime = 3600 * hours;
 
-    for (auto &[callsign, time, rssi, snr, content, count, digipeaterCallsign, digipeaterCount, reserved] : system->settings.aprsCallsignsHeard) {
+    for (auto station = system->aprsHeard.first(); station != nullptr && now - station->time <= maxTime; station = system->aprsHeard.next(station)) {
         if (strlen(response) >= MyCommandParser::MAX_RESPONSE_SIZE - 10) {
             return;
         }
 
-        if (strlen(callsign) > 0 && strlen(content) > 0) {
-            if (strlen(response) > 0) {
-                strncat_P(response, PSTR(" "), MyCommandParser::MAX_RESPONSE_SIZE - strlen(response));
-            }
-
-            if (now - time <= maxTime) {
-                snprintf_P(response + strlen(response), MyCommandParser::MAX_RESPONSE_SIZE - strlen(response), PSTR("%s(%d)"), callsign, digipeaterCount);
-            }
+        if (strlen(response) > 0) {
+            strncat_P(response, PSTR(" "), MyCommandParser::MAX_RESPONSE_SIZE - strlen(response));
         }
+
+        snprintf_P(response + strlen(response), MyCommandParser::MAX_RESPONSE_SIZE - strlen(response), PSTR("%s(%d)"), station->callsign, station->digipeaterCount);
     }
 
     if (strlen(response) == 0) {
@@ -727,26 +532,34 @@ void Command::doAprsHeard(MyCommandParser::Argument *args, char *response) {
     }
 }
 
+// Of snprintf in the response, which is cut when longer
+static void checkResponseLength(const int written) {
+    if (written >= static_cast<int>(MyCommandParser::MAX_RESPONSE_SIZE)) {
+        Log.warningln(F("[COMMAND] Response of %d characters cut to %d"), written, MyCommandParser::MAX_RESPONSE_SIZE - 1);
+    }
+}
+
 // ?APRSH CALL
 void Command::doAprsHeardSomeone(MyCommandParser::Argument *args, char *response) {
-    for (auto &[callsign, time, rssi, snr, content, count, digipeaterCallsign, digipeaterCount, reserved] : system->settings.aprsCallsignsHeard) {
-        if (strcasecmp(callsign, args[0].asString) == 0) {
-            getDateTimeStringFromEpoch(time, bufferText, BUFFER_LENGTH);
-            snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s SNR:%.2f RSSI:%.2f Digi:%d Last:%s Count:%llu"), bufferText, snr, rssi, digipeaterCount, digipeaterCallsign, count);
-            return;
-        }
+    if (const auto station = system->aprsHeard.find(args[0].asString); station != nullptr) {
+        char date[21]; // 2024-01-01T00:00:00Z
+        getDateTimeStringFromEpoch(station->time, date, sizeof(date));
+
+        checkResponseLength(snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s SNR:%.2f RSSI:%.2f Digi:%d Last:%s Count:%lu"), date, station->snr, station->rssi, station->digipeaterCount, station->digipeaterCallsign, static_cast<unsigned long>(station->count)));
+        return;
     }
 
-    snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s pas entendu"), args[0].asString);
+    // Longer than a callsign, it can't have been heard
+    snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%.*s pas entendu"), CALLSIGN_LENGTH - 1, args[0].asString);
 }
 
 void Command::doAbout(MyCommandParser::Argument *args, char *response) {
-    snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s %s %s %s"), system->settings.aprs.comment, system->settings.aprs.status, system->settings.meshtastic.itemComment, system->settings.linux.itemComment);
+    checkResponseLength(snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, PSTR("%s %s %s %s"), system->settings.aprs.comment, system->settings.aprs.status, system->settings.meshtastic.itemComment, system->settings.linux.itemComment));
 }
 
 void Command::doAprsPing(MyCommandParser::Argument *args, char *response) {
-    if (system->lastAprsHeard != nullptr) {
-        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, "Pong %s! SNR: %.2f RSSI: %.2f", system->lastAprsHeard->callsign, system->lastAprsHeard->snr, system->lastAprsHeard->rssi);
+    if (const auto lastAprsHeard = system->aprsHeard.getLast(); lastAprsHeard != nullptr) {
+        snprintf_P(response, MyCommandParser::MAX_RESPONSE_SIZE, "Pong %s! SNR: %.2f RSSI: %.2f", lastAprsHeard->callsign, lastAprsHeard->snr, lastAprsHeard->rssi);
     } else {
         doPing(args, response);
     }
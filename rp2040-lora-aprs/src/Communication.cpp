@@ -1,5 +1,6 @@
+#include <hardware/sync.h>
 #include "Communication.h"
-#include "ArduinoLog.h"
+#include "Logging.h"
 #include "utils.h"
 #include "System.h"
 
@@ -18,6 +19,13 @@ bool Communication::begin() {
     digitalWrite(LORA_CS, HIGH);
     SPI1.begin(false);
 
+    if (frameTx != nullptr) {
+        txQueue.pop(frameTx, false);
+        frameTx = nullptr;
+    }
+
+    state = LoRaReceiving;
+
     const SettingsLoRa settings = system->settings.lora;
 
     if (lora.begin(settings.frequency, settings.bandwidth, settings.spreadingFactor, settings.codingRate, RADIOLIB_SX126X_SYNC_WORD_PRIVATE, settings.outputPower, LORA_PREAMBLE_LENGTH, 0, false) != RADIOLIB_ERR_NONE) {
@@ -51,6 +59,9 @@ bool Communication::begin() {
         return false;
     }
 
+    activeLoRa = settings;
+    scheduler.switched(LORA_PROFILE_APRS);
+
     if (!startReceive()) {
         return false;
     }
@@ -64,27 +75,107 @@ void Communication::setHasInterrupt() {
     hasInterrupt = true;
 }
 
+uint16_t Communication::readInterrupt() {
+    if (!hasInterrupt) {
+        return 0;
+    }
+
+    hasInterrupt = false;
+    const uint16_t irqFlags = lora.getIrqFlags();
+
+    LOG_TRACE(F("[LORA] Interrupt with flags : %d"), irqFlags);
+
+    return irqFlags;
+}
+
 void Communication::update() {
-    if (hasInterrupt) {
-        hasInterrupt = false;
-        const uint16_t irqFlags = lora.getIrqFlags();
-
-        Log.traceln(F("[LORA] Interrupt with flags : %d"), irqFlags);
-
-        if (irqFlags & RADIOLIB_SX126X_IRQ_RX_DONE) {
-            memset(buffer, '\0', TRX_BUFFER);
-            const size_t size = lora.getPacketLength();
-            const int state = lora.readData(buffer, size);
-            if (state == RADIOLIB_ERR_NONE && size >= 15) {
-                received(buffer, size, lora.getRSSI(), lora.getSNR());
+    queueRequests();
+
+    const uint16_t irqFlags = readInterrupt();
+
+    if (irqFlags && isListening()) {
+        readReceived(irqFlags);
+        updateTransmit(0);
+    } else {
+        updateTransmit(irqFlags);
+    }
+}
+
+void Communication::readReceived(const uint16_t irqFlags) {
+    if (!(irqFlags & RADIOLIB_SX126X_IRQ_RX_DONE)) {
+        startReceive();
+        return;
+    }
+
+    const size_t size = lora.getPacketLength();
+    // One byte left for the end of string used by the decoder, so no need to clear the buffer
+    const int state = lora.readData(buffer, size < TRX_BUFFER ? size : TRX_BUFFER - 1);
+    if (state == RADIOLIB_ERR_NONE && size >= 15 && size < TRX_BUFFER) {
+        buffer[size] = '\0';
+        received(buffer, size, lora.getRSSI(), lora.getSNR());
+    }
+}
+
+void Communication::updateTransmit(const uint16_t irqFlags) {
+    switch (state) {
+        case LoRaReceiving:
+            updateScheduler();
+            startNext();
+            break;
+        case LoRaWaitChannelFree:
+            if (timerState.hasExpired()) {
+                startChannelScan();
+            }
+            break;
+        case LoRaChannelScan:
+            if (irqFlags & RADIOLIB_SX126X_IRQ_CAD_DONE) {
+                channelScanned(lora.getChannelScanResult());
+            } else if (timerState.hasExpired()) {
+                Log.errorln(F("[LORA] Timeout during test channel free"));
+                startTransmit();
+            }
+            break;
+        case LoRaTransmitting:
+            if (irqFlags & RADIOLIB_SX126X_IRQ_TX_DONE) {
+                lora.finishTransmit();
+                sent();
+            } else if (timerState.hasExpired()) {
+                if (system->settings.lora.txEnabled) {
+                    Log.errorln(F("[LORA] TX Error timeout"));
+                    _hasError = true;
+                    lora.finishTransmit();
+                    abortTransmit();
+                } else {
+                    sent();
+                }
             }
+            break;
+        case LoRaAfterTransmit:
+            if (timerState.hasExpired()) {
+                state = LoRaReceiving;
+            }
+            break;
+    }
+}
+
+void Communication::waitEndOfTransmit() {
+    // Finish the frame in flight, the queued ones stay queued. Frames heard meanwhile are handled as usual,
+    // a digipeat of them is only queued.
+    while (state != LoRaReceiving) {
+        const uint16_t irqFlags = readInterrupt();
+
+        if (irqFlags && isListening()) {
+            readReceived(irqFlags);
         } else {
-            startReceive();
+            updateTransmit(irqFlags);
         }
+
+        delay(1);
+        rp2040.wdt_reset();
     }
 }
 
-bool Communication::sendAprsFrame() {
+bool Communication::sendAprsFrame(const TxPriority priority) {
     size_t size = Aprs::encode(&aprsPacketTx, bufferText);
 
     if (!size) {
@@ -97,32 +188,223 @@ bool Communication::sendAprsFrame() {
         return false;
     }
 
-    buffer[0] = '<';
-    buffer[1]= 0xFF;
-    buffer[2] = 0x01;
+    TxRequest *request = txRequests.reserve();
+
+    if (request == nullptr) {
+        Log.errorln(F("[LORA_TX] Radio core is late, frame dropped"));
+        return false;
+    }
+
+    request->size = 0;
+
+    if (system->settings.lora.frameFormat == LoRaFrameAx25) {
+        request->size = Ax25::encode(bufferText, size, request->data, TRX_BUFFER);
+
+        if (!request->size) {
+            Log.warningln(F("[APRS] Not an AX.25 address, sent as text"));
+        }
+    }
+
+    if (!request->size) {
+        request->data[0] = '<';
+        request->data[1]= 0xFF;
+        request->data[2] = 0x01;
+
+        memcpy(request->data + 3, bufferText, size);
+        request->size = size + 3;
+    }
+
+    request->priority = priority;
+
+    LOG_HEX_DUMP("[LORA_TX]", request->data, request->size);
+
+    Log.infoln(F("[LORA_TX] Send %d bytes with priority %d : %s"), request->size, priority, bufferText);
+
+    txRequests.commit();
+    __sev();
+
+    return true;
+}
+
+bool Communication::sendRaw(const uint8_t* payload, size_t size, const TxPriority priority) {
+    if (size > TRX_BUFFER) {
+        Log.errorln(F("[LORA_TX] Error during raw send. Size of %d is out of %d"), size, TRX_BUFFER);
+        return false;
+    }
+
+    TxRequest *request = txRequests.reserve();
 
-    for (uint8_t i = 0; i < size; i++) {
-        buffer[i + 3] = bufferText[i];
-        Log.verboseln(F("[LORA_TX] Payload[%d]=%X %c"), i + 3, buffer[i + 3], buffer[i + 3]);
+    if (request == nullptr) {
+        Log.errorln(F("[LORA_TX] Radio core is late, frame dropped"));
+        return false;
     }
 
-    return send(size + 3);
+    memcpy(request->data, payload, size);
+    request->size = size;
+    request->priority = priority;
+
+    txRequests.commit();
+    __sev();
+
+    return true;
+}
+
+void Communication::queueRequests() {
+    while (const TxRequest *request = txRequests.front()) {
+        queueFrame(request->data, request->size, request->priority);
+        txRequests.pop();
+    }
 }
 
-bool Communication::sendRaw(const uint8_t* payload, size_t size) {
+bool Communication::queueFrame(const uint8_t* payload, size_t size, const TxPriority priority) {
     if (size > TRX_BUFFER) {
         Log.errorln(F("[LORA_TX] Error during raw send. Size of %d is out of %d"), size, TRX_BUFFER);
         return false;
     }
 
-    memcpy(buffer, payload, size);
+    TxQueueFrame *frame = txQueue.push(priority);
+
+    if (frame == nullptr) {
+        return false;
+    }
+
+    memcpy(frame->data, payload, size);
+    frame->size = size;
+
+    Log.infoln(F("[LORA_TX] Queue %d bytes with priority %d"), size, priority);
+
+    if (state == LoRaReceiving) {
+        startNext();
+    }
+
+    return true;
+}
+
+bool Communication::digipeat(const uint8_t *payload, const size_t size, const bool asAx25) {
+    // Only the path changes, so the received frame is copied around the new one instead of being encoded again
+    const auto header = reinterpret_cast<const char *>(payload + 3);
+    const auto headerEnd = static_cast<const char *>(memchr(header, ':', size - 3));
+
+    if (headerEnd == nullptr) {
+        Log.errorln(F("[LORA_TX] Digipeat without end of header"));
+        return false;
+    }
+
+    const auto pathStart = static_cast<const char *>(memchr(header, ',', headerEnd - header));
+    const size_t addressesSize = 3 + ((pathStart != nullptr ? pathStart : headerEnd) - header); // With the LoRa APRS bytes
+    const size_t pathSize = strlen(aprsPacketRx.path);
+    const size_t informationSize = reinterpret_cast<const char *>(payload + size) - headerEnd; // With the ':'
+    const size_t frameSize = addressesSize + 1 + pathSize + informationSize;
+
+    if (frameSize > TRX_BUFFER) {
+        Log.errorln(F("[LORA_TX] Error during digipeat. Size of %d is out of %d"), frameSize, TRX_BUFFER);
+        return false;
+    }
+
+    TxQueueFrame *frame = txQueue.push(TxPriorityDigipeat);
+
+    if (frame == nullptr) {
+        return false;
+    }
+
+    memcpy(frame->data, payload, addressesSize);
+    frame->data[addressesSize] = ',';
+    memcpy(frame->data + addressesSize + 1, aprsPacketRx.path, pathSize);
+    memcpy(frame->data + addressesSize + 1 + pathSize, headerEnd, informationSize);
+    frame->size = frameSize;
+
+    // Sent back in the format heard, the text one is kept if the new path can't be encoded
+    if (asAx25) {
+        if (const size_t ax25Size = Ax25::encode(reinterpret_cast<const char *>(frame->data + 3), frameSize - 3, bufferAx25, sizeof(bufferAx25)); ax25Size) {
+            memcpy(frame->data, bufferAx25, ax25Size);
+            frame->size = ax25Size;
+        }
+    }
+
+    Log.infoln(F("[LORA_TX] Queue digipeat of %d bytes"), frame->size);
+
+    if (state == LoRaReceiving) {
+        startNext();
+    }
+
+    return true;
+}
+
+bool Communication::changeLoRaSettings(const float frequency, const uint16_t bandwidth, const uint8_t spreadingFactor, const uint8_t codingRate,
+    const uint8_t outputPower) {
+    requestedLoRa.frequency = frequency;
+    requestedLoRa.bandwidth = bandwidth;
+    requestedLoRa.spreadingFactor = spreadingFactor;
+    requestedLoRa.codingRate = codingRate;
+    requestedLoRa.outputPower = outputPower;
+
+    return system->runOnRadioCore(applyRequestedLoRa);
+}
+
+bool Communication::holdLoRaProfile(const int8_t profile) {
+    requestedProfile = profile;
+
+    return system->runOnRadioCore(applyRequestedProfile);
+}
+
+bool Communication::applyRequestedLoRa(System *system) {
+    return system->communication.applyLoRaSettings(system->communication.requestedLoRa);
+}
+
+bool Communication::applyRequestedProfile(System *system) {
+    Communication &communication = system->communication;
+
+    communication.waitEndOfTransmit();
+    communication.scheduler.hold(communication.requestedProfile);
+
+    if (!communication.updateScheduler()) {
+        communication.scheduler.hold(LORA_PROFILE_AUTO);
+        return false;
+    }
+
+    return true;
+}
+
+bool Communication::restartScheduler() {
+    waitEndOfTransmit();
+
+    return switchProfile(LORA_PROFILE_APRS);
+}
+
+bool Communication::updateScheduler() {
+    const int8_t profile = scheduler.update(system->settings.loraScheduler);
+
+    return profile == LORA_PROFILE_AUTO || switchProfile(profile);
+}
+
+bool Communication::switchProfile(const uint8_t profile) {
+    SettingsLoRa settings;
+    LoRaScheduler::parameters(profile, system->settings, &settings);
+
+    Log.infoln(F("[LORA] Switch to profile %s"), LoRaScheduler::getName(profile, system->settings.loraScheduler));
+
+    // On error, begin() is back on the APRS channel
+    if (!applyLoRaSettings(settings)) {
+        return false;
+    }
+
+    scheduler.switched(profile);
 
-    return send(size);
+    return true;
 }
 
-bool Communication::changeLoRaSettings(float frequency, uint16_t bandwidth, uint8_t spreadingFactor, uint8_t codingRate,
-    uint8_t outputPower) {
-    if (!lora.setFrequency(frequency) || !lora.setBandwidth(bandwidth) || !lora.setSpreadingFactor(spreadingFactor) || !lora.setCodingRate(codingRate) || !lora.setOutputPower(outputPower)) {
+bool Communication::applyLoRaSettings(const SettingsLoRa &settings) {
+    const float frequency = settings.frequency;
+    const uint16_t bandwidth = settings.bandwidth;
+    const uint8_t spreadingFactor = settings.spreadingFactor;
+    const uint8_t codingRate = settings.codingRate;
+    const uint8_t outputPower = settings.outputPower;
+
+    waitEndOfTransmit();
+    lora.standby();
+
+    if (lora.setFrequency(frequency) != RADIOLIB_ERR_NONE || lora.setBandwidth(bandwidth) != RADIOLIB_ERR_NONE || lora.setSpreadingFactor(spreadingFactor) != RADIOLIB_ERR_NONE
+        || lora.setCodingRate(codingRate) != RADIOLIB_ERR_NONE || lora.setOutputPower(outputPower) != RADIOLIB_ERR_NONE) {
         Log.errorln(F("[LORA] Error during change changed to frequency: %f, bandwidth: %d, spreading factor: %d, coding rate: %d, output power: %d. Reload default"), frequency, bandwidth, spreadingFactor, codingRate, outputPower);
         begin();
         return false;
@@ -130,53 +412,153 @@ bool Communication::changeLoRaSettings(float frequency, uint16_t bandwidth, uint
 
     Log.infoln(F("[LORA] Settings changed to frequency: %f, bandwidth: %d, spreading factor: %d, coding rate: %d, output power: %d"), frequency, bandwidth, spreadingFactor, codingRate, outputPower);
 
-    return true;
+    activeLoRa = settings;
+
+    return startReceive();
 }
 
-bool Communication::send(const size_t size) {
+void Communication::startNext() {
+    const SettingsLoRa &settings = system->settings.lora;
+
+    // Frames of the APRS channel wait for its slot, KISS ones are sent on any profile
+    while ((frameTx = txQueue.next(scheduler.getProfile() != LORA_PROFILE_APRS)) != nullptr) {
+        const uint32_t timeOnAir = Airtime::timeOnAir(frameTx->size, activeLoRa);
+
+        if (frameTx->priority == TxPriorityBeacon && !airtime.isAllowed(timeOnAir, settings.dutyCycle, AIRTIME_BEACON_BUDGET_PERCENT)) {
+            Log.warningln(F("[LORA_TX] Beacon of %dms dropped, airtime of last hour is %dms"), timeOnAir, airtime.lastHour());
+            airtime.dropped++;
+            txQueue.pop(frameTx, false);
+            continue;
+        }
+
+        if (!airtime.isAllowed(timeOnAir, settings.dutyCycle)) {
+            if (!isDeferred) {
+                Log.warningln(F("[LORA_TX] Frame of %dms deferred, airtime of last hour is %dms"), timeOnAir, airtime.lastHour());
+                airtime.deferred++;
+                isDeferred = true;
+            }
+
+            frameTx = nullptr;
+            return;
+        }
+
+        break;
+    }
+
+    if (frameTx == nullptr) {
+        return;
+    }
+
+    isDeferred = false;
+    frameTx->inFlight = true;
+
     system->gpioLed.setState(HIGH);
 
-    Log.infoln(F("[LORA_TX] Start send %d bytes : %s"), size, bufferText);
+    Log.infoln(F("[LORA_TX] Start send %d bytes, %d in queue"), frameTx->size, txQueue.depth());
+
+    channelScanTries = 0;
+
+    startChannelScan();
+}
+
+void Communication::abortTransmit() {
+    system->gpioLed.setState(LOW);
+
+    txQueue.pop(frameTx, false);
+    frameTx = nullptr;
+
+    startReceive();
+    state = LoRaReceiving;
+}
+
+void Communication::startChannelScan() {
+    LOG_TRACE(F("[LORA] Test channel is active"));
+
+    lora.standby();
+
+    const auto result = lora.startChannelScan();
+    if (result != RADIOLIB_ERR_NONE) {
+        Log.errorln(F("[LORA] Error during test channel free: %d"), result);
+        startTransmit();
+        return;
+    }
+
+    state = LoRaChannelScan;
+    timerState.setInterval(TIME_CHANNEL_SCAN_TIMEOUT);
+    timerState.restart();
+}
+
+void Communication::channelScanned(const int16_t result) {
+    if (result == RADIOLIB_LORA_DETECTED) {
+        Log.warningln(F("[LORA] Channel is already active"));
+
+        if (++channelScanTries >= MAX_CHANNEL_SCAN_TRIES) {
+            Log.errorln(F("[LORA_TX] Can't send because too much signal on channel"));
+            abortTransmit();
+            return;
+        }
 
-    uint8_t i = 0;
-    while (i++ < 3 && isChannelActive()) {
         startReceive();
-        delayWdt(TIME_WAIT_CHANNEL_ACTIVE);
+
+        state = LoRaWaitChannelFree;
+        timerState.setInterval(TIME_WAIT_CHANNEL_ACTIVE);
+        timerState.restart();
+        return;
     }
-    if (i == 3) {
-        Log.errorln(F("[LORA_TX] Can't send because too much signal on channel"));
-        return false;
+
+    if (result != RADIOLIB_CHANNEL_FREE) {
+        Log.errorln(F("[LORA] Error during test channel free: %d"), result);
+    } else {
+        LOG_TRACE(F("[LORA] Channel is free"));
+
+        if (!system->kiss.shouldTransmit()) { // p-persistence set by the KISS host
+            LOG_TRACE(F("[LORA] Wait a slot time before testing channel again"));
+
+            startReceive();
+
+            state = LoRaWaitChannelFree;
+            timerState.setInterval(system->kiss.getSlotTime());
+            timerState.restart();
+            return;
+        }
+    }
+
+    startTransmit();
+}
+
+void Communication::startTransmit() {
+    state = LoRaTransmitting;
+
+    if (!system->settings.lora.txEnabled) {
+        timerState.setInterval(TIME_TX_DISABLED);
+        timerState.restart();
+        return;
     }
 
-    if (system->settings.lora.txEnabled) {
-        const int currentState = lora.transmit(buffer, size);
+    const int currentState = lora.startTransmit(frameTx->data, frameTx->size);
 
-        if (currentState == RADIOLIB_ERR_NONE) {
-            sent();
-        } else if (currentState == RADIOLIB_ERR_PACKET_TOO_LONG) {
+    if (currentState != RADIOLIB_ERR_NONE) {
+        if (currentState == RADIOLIB_ERR_PACKET_TOO_LONG) {
             Log.errorln(F("[LORA] TX Error too long"));
-            _hasError = true;
-            return false;
-        } else if (currentState == RADIOLIB_ERR_TX_TIMEOUT) {
-            Log.errorln(F("[LORA] TX Error timeout"));
-            _hasError = true;
-            return false;
         } else {
-            sprintf_P(bufferText, PSTR("[LORA] TX Error : %d"), currentState);
-            _hasError = true;
-            Log.errorln(bufferText);
-            return false;
+            Log.errorln(F("[LORA] TX Error : %d"), currentState);
         }
-    }
-    else {
-        delayWdt(1000);
-        sent();
+
+        _hasError = true;
+        abortTransmit();
+        return;
     }
 
-    return true;
+    const uint32_t timeOnAir = Airtime::timeOnAir(frameTx->size, activeLoRa);
+    airtime.add(timeOnAir);
+    scheduler.sent(timeOnAir);
+
+    // Same margin as RadioLib blocking transmit()
+    timerState.setInterval(lora.getTimeOnAir(frameTx->size) * 3 / 2 / 1000);
+    timerState.restart();
 }
 
-bool Communication::sendMessage(const char* destination, const char* message, const char* ackToConfirm) {
+bool Communication::sendMessage(const char* destination, const char* message, const char* ackToConfirm, const TxPriority priority) {
     Aprs::reset(&aprsPacketTx);
 
     const SettingsAprs settings = system->settings.aprs;
@@ -188,13 +570,13 @@ bool Communication::sendMessage(const char* destination, const char* message, co
     strcpy(aprsPacketTx.message.destination, destination);
     strcpy(aprsPacketTx.message.message, message);
 
-    if (strlen(ackToConfirm) > 0) {
+    if (ackToConfirm != nullptr && strlen(ackToConfirm) > 0) {
         strcpy(aprsPacketTx.message.ackToConfirm, ackToConfirm);
     }
 
     aprsPacketTx.type = Message;
 
-    return sendAprsFrame();
+    return sendAprsFrame(priority);
 }
 
 void Communication::prepareTelemetry() {
@@ -202,7 +584,8 @@ void Communication::prepareTelemetry() {
     system->settings.aprs.telemetrySequenceNumber = aprsPacketTx.telemetries.telemetrySequenceNumber;
     system->saveSettings();
 
-    sprintf_P(aprsPacketTx.comment, PSTR("Bat:%d%% Up:%ld"), system->energyThread->getBatteryPercentage(), millis() / 1000);
+    sprintf_P(aprsPacketTx.comment, PSTR("Bat:%d%% Shed:%d Up:%ld Air:%lus Wh:%lu/%lu"), system->energyThread->getBatteryPercentage(), system->loadSheddingThread->getTier(), millis() / 1000, static_cast<unsigned long>(airtime.lastHour() / 1000),
+              static_cast<unsigned long>(system->energyBudget.lastDayConsumed() / 1000), static_cast<unsigned long>(system->energyBudget.lastDayHarvested() / 1000));
 
     double temperatureBox = 0;
     double temperatureBoxNb = 0;
@@ -404,67 +787,99 @@ void Communication::sent() {
 
     Log.infoln(F("[LORA_TX] End"));
 
+    txQueue.pop(frameTx);
+    frameTx = nullptr;
+
     if (system->watchdogSlaveLoraTxThread->enabled) {
         system->watchdogSlaveLoraTxThread->feed();
     }
 
     startReceive();
 
-    delayWdt(TIME_AFTER_TX); // Time for others receivers to return to RX mode. It is a test where I missed some frames
+    // Time for others receivers to return to RX mode. It is a test where I missed some frames
+    state = LoRaAfterTransmit;
+    timerState.setInterval(TIME_AFTER_TX);
+    timerState.restart();
 }
 
 void Communication::received(uint8_t * payload, const uint16_t size, const float rssi, const float snr) {
-    Log.traceln(F("[LORA_RX] Payload of size %d, RSSI : %F and SNR : %F"), size, rssi, snr);
-    Log.infoln(F("[LORA_RX] %s"), payload);
-
-    for (uint16_t i = 0; i < size; i++) {
-        Log.verboseln(F("[LORA_RX] Payload[%d]=%X %c"), i, payload[i], payload[i]);
-    }
+    LOG_TRACE(F("[LORA_RX] Payload of size %d, RSSI : %F and SNR : %F"), size, rssi, snr);
+    LOG_HEX_DUMP("[LORA_RX]", payload, size);
 
     system->gpioLed.setState(HIGH);
+    scheduler.received();
 
     bool shouldTx = false;
 
-    if (!Aprs::decode(reinterpret_cast<const char *>(payload + sizeof(uint8_t) * 3), &aprsPacketRx)) {
-        Log.warningln(F("[APRS] Error during decode, KISS ?"));
-        system->sendToKissInterface(payload, size);
+    // Both formats are heard whatever lora.frameFormat, AX.25 is converted to the text one. A text frame can't be
+    // taken for AX.25 as '<' is not a shifted address character.
+    const uint8_t *text = payload;
+    uint16_t textSize = size;
+    size_t ax25TextLength = 0;
+
+    if (size < 3 || payload[0] != '<' || payload[1] != 0xFF || payload[2] != 0x01) {
+        ax25TextLength = Ax25::decode(payload, size, bufferAx25Text + 3, sizeof(bufferAx25Text) - 3);
+    }
+
+    if (ax25TextLength) {
+        bufferAx25Text[0] = '<';
+        bufferAx25Text[1] = static_cast<char>(0xFF);
+        bufferAx25Text[2] = 0x01;
+
+        text = reinterpret_cast<const uint8_t *>(bufferAx25Text);
+        textSize = ax25TextLength + 3;
+
+        Log.infoln(F("[LORA_RX] AX.25 %s"), bufferAx25Text + 3);
     } else {
-        Log.traceln(F("[APRS] Decoded from %s to %s via %s"), aprsPacketRx.source, aprsPacketRx.destination, aprsPacketRx.path);
+        Log.infoln(F("[LORA_RX] %s"), payload);
+    }
 
-        system->addAprsFrameReceivedToHistory(&aprsPacketRx, snr, rssi);
+    const bool isAprs = Aprs::decode(reinterpret_cast<const char *>(text + sizeof(uint8_t) * 3), &aprsPacketRx);
 
-        const SettingsAprs settings = system->settings.aprs;
+    // As heard on air, the KISS host gets text frames in AX.25
+    system->kiss.received(payload, size, isAprs, rssi, snr);
 
-        if (strcasecmp(aprsPacketRx.source, settings.call) == 0) {
-            Log.warningln(F("[APRS] It's from us. Bug ? Ignore it"));
-            return;
+    if (!isAprs) {
+        Log.warningln(F("[APRS] Error during decode, KISS ?"));
+    } else {
+        LOG_TRACE(F("[APRS] Decoded from %s to %s via %s"), aprsPacketRx.source, aprsPacketRx.destination, aprsPacketRx.path);
+
+        // Heard list and messages are for the main core, the digipeat is done here without waiting for it
+        if (RxFrame *frame = rxFrames.reserve(); frame != nullptr) {
+            frame->packet = aprsPacketRx;
+            frame->rssi = rssi;
+            frame->snr = snr;
+            rxFrames.commit();
+            __sev();
+        } else {
+            Log.errorln(F("[LORA_RX] Main core is late, frame not handled"));
         }
 
-        if (strstr(aprsPacketRx.message.destination, settings.call) != nullptr) {
-            Log.traceln(F("[APRS] Message for me : %s"), aprsPacketRx.message.message);
+        const SettingsAprs &settings = system->settings.aprs;
 
-            if (strlen(aprsPacketRx.message.message) > 0) {
-                if (strlen(aprsPacketRx.message.ackToConfirm) > 0) {
-                    shouldTx = sendMessage(aprsPacketRx.source, PSTR(""), aprsPacketRx.message.ackToConfirm);
+        if (strcasecmp(aprsPacketRx.source, settings.call) == 0) {
+            Log.warningln(F("[APRS] It's from us. Bug ? Ignore it"));
+        } else if (strstr(aprsPacketRx.message.destination, settings.call) == nullptr && settings.digipeaterEnabled) {
+            // Remembered even when not digipeated, as it is already on air
+            if (dupeCache.isDuplicate(DupeCache::hash(&aprsPacketRx))) {
+                Log.infoln(F("[APRS] Duplicate of a frame heard less than %ds ago, not digipeated"), DUPE_CACHE_WINDOW / 1000);
+            } else {
+                // From the path as received, the rewrite of canBeDigipeated() adds our own call with a '*'
+                const bool isHeardDirectly = strchr(aprsPacketRx.path, '*') == nullptr;
+
+                shouldTx = Aprs::canBeDigipeated(aprsPacketRx.path, settings.call);
+
+                if (shouldTx && digipeatOnlyDirect.load(std::memory_order_relaxed) && !isHeardDirectly) {
+                    Log.infoln(F("[APRS] Not heard directly, not digipeated to save the battery"));
+                    shouldTx = false;
                 }
-
-                system->command.processCommand(nullptr, aprsPacketRx.message.message);
-
-                shouldTx |= sendMessage(aprsPacketRx.source, system->command.response);
             }
-        } else if (settings.digipeaterEnabled) {
-            shouldTx = Aprs::canBeDigipeated(aprsPacketRx.path, settings.call);
 
-            Log.traceln(F("[APRS] Message should TX : %T"), shouldTx);
+            LOG_TRACE(F("[APRS] Message should TX : %T"), shouldTx);
 
             if (shouldTx) {
                 Log.infoln(F("[APRS] Message digipeated via %s"), aprsPacketRx.path);
-                strcpy(aprsPacketTx.source, aprsPacketRx.source);
-                strcpy(aprsPacketTx.path, aprsPacketRx.path);
-                strcpy(aprsPacketTx.destination, aprsPacketRx.destination);
-                strcpy(aprsPacketTx.content, aprsPacketRx.content);
-                aprsPacketTx.type = RawContent;
-                shouldTx = sendAprsFrame();
+                shouldTx = digipeat(text, textSize, ax25TextLength != 0);
             }
         }
     }
@@ -474,28 +889,34 @@ void Communication::received(uint8_t * payload, const uint16_t size, const float
     }
 }
 
-bool Communication::isChannelActive() {
-    Log.traceln(F("[LORA] Test channel is active"));
+void Communication::processReceived() {
+    while (RxFrame *frame = rxFrames.front()) {
+        const AprsPacketLite &packet = frame->packet;
 
-    lora.standby();
+        system->binaryLink.heard(system->aprsHeard.add(&packet, system->getDateTime().unixtime(), frame->snr, frame->rssi));
 
-    const auto result = lora.scanChannel();
-    if (result == RADIOLIB_LORA_DETECTED) {
-        Log.warningln(F("[LORA] Channel is already active"));
-        return true;
-    }
+        const SettingsAprs &settings = system->settings.aprs;
 
-    if (result != RADIOLIB_CHANNEL_FREE) {
-        Log.errorln(F("[LORA] Error during test channel free: %d"), result);
-    } else {
-        Log.traceln(F("[LORA] Channel is free"));
-    }
+        if (strcasecmp(packet.source, settings.call) != 0 && strstr(packet.message.destination, settings.call) != nullptr) {
+            LOG_TRACE(F("[APRS] Message for me : %s"), packet.message.message);
 
-    return false;
+            if (strlen(packet.message.message) > 0) {
+                if (strlen(packet.message.ackToConfirm) > 0) {
+                    sendMessage(packet.source, PSTR(""), packet.message.ackToConfirm, TxPriorityAck);
+                }
+
+                system->command.processCommand(nullptr, packet.message.message);
+
+                sendMessage(packet.source, system->command.response, nullptr, TxPriorityAck);
+            }
+        }
+
+        rxFrames.pop();
+    }
 }
 
 bool Communication::startReceive() {
-    Log.traceln(F("[LORA] Start receive"));
+    LOG_TRACE(F("[LORA] Start receive"));
 
     lora.standby();
 
@@ -505,7 +926,7 @@ bool Communication::startReceive() {
         return false;
     }
 
-    Log.traceln(F("[LORA] Start receive OK"));
+    LOG_TRACE(F("[LORA] Start receive OK"));
 
     return true;
 }
@@ -0,0 +1,43 @@
+#include "DupeCache.h"
+
+// FNV-1a, the separator avoids the same hash when a character moves from a field to the next one
+static uint32_t hashString(uint32_t hash, const char *value, const char separator) {
+    for (; *value != '\0'; value++) {
+        hash ^= static_cast<uint8_t>(*value);
+        hash *= 16777619;
+    }
+
+    hash ^= static_cast<uint8_t>(separator);
+    hash *= 16777619;
+
+    return hash;
+}
+
+uint32_t DupeCache::hash(const AprsPacketLite *packet) {
+    uint32_t hash = 2166136261;
+
+    hash = hashString(hash, packet->source, '>');
+    hash = hashString(hash, packet->destination, ':');
+    hash = hashString(hash, packet->content, '\0');
+
+    return hash;
+}
+
+bool DupeCache::isDuplicate(const uint32_t hash) {
+    const unsigned long now = millis();
+
+    checked++;
+
+    for (const auto &entry : entries) {
+        if (entry.used && entry.hash == hash && now - entry.seenAt < DUPE_CACHE_WINDOW) {
+            hits++;
+            return true;
+        }
+    }
+
+    // Entries are in order of reception, so the next one is the oldest
+    entries[next] = {hash, now, true};
+    next = (next + 1) % DUPE_CACHE_SIZE;
+
+    return false;
+}
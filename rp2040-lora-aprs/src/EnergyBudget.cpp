@@ -0,0 +1,132 @@
+#include "EnergyBudget.h"
+#include "utils.h"
+
+static float toMilliwattHours(const float milliwatts, const uint32_t milliseconds) {
+    return milliwatts * static_cast<float>(milliseconds) / 3600000;
+}
+
+void EnergyBudget::add(const EnergySample &sample) {
+    if (!hasPrevious) {
+        previous = sample;
+        hasPrevious = true;
+        return;
+    }
+
+    const uint32_t duration = sample.time - previous.time;
+    if (duration == 0) {
+        return;
+    }
+
+    uint32_t airtime = sample.airtime - previous.airtime;
+    if (airtime > duration) {
+        airtime = duration;
+    }
+
+    uint32_t waiting = (sample.timeWaiting - previous.timeWaiting) / 1000;
+    if (waiting > duration - airtime) {
+        waiting = duration - airtime;
+    }
+
+    const uint32_t frames = sample.framesSent - previous.framesSent;
+    previous = sample;
+
+    // Only instant measures, taken as the average of the interval
+    const float consumed = clamp(static_cast<float>(sample.voltageBattery) * sample.currentBattery / 1000, 0, INFINITY);
+    const float solar = clamp(static_cast<float>(sample.voltageSolar) * sample.currentSolar / 1000, 0, INFINITY);
+
+    float shares[ENERGY_CONSUMER_COUNT]{};
+    shares[EnergyTx] = clamp(static_cast<float>(ENERGY_TX_POWER) * airtime / duration, 0, consumed);
+    float left = consumed - shares[EnergyTx];
+
+    if (!sample.linuxPowered && !sample.meshtasticPowered) {
+        learn(EnergyIdle, left);
+    } else if (hasLearnt[EnergyIdle] && sample.linuxPowered != sample.meshtasticPowered) {
+        learn(sample.linuxPowered ? EnergyLinux : EnergyMeshtastic, left - power[EnergyIdle]);
+    }
+
+    if (sample.linuxPowered) {
+        shares[EnergyLinux] = clamp(power[EnergyLinux], 0, left);
+        left -= shares[EnergyLinux];
+    }
+
+    if (sample.meshtasticPowered) {
+        shares[EnergyMeshtastic] = clamp(power[EnergyMeshtastic], 0, left);
+        left -= shares[EnergyMeshtastic];
+    }
+
+    shares[EnergySleep] = left * waiting / duration;
+    shares[EnergyIdle] = left - shares[EnergySleep];
+
+    const uint8_t hour = bucket(sample.time);
+
+    for (uint8_t consumer = 0; consumer < ENERGY_CONSUMER_COUNT; consumer++) {
+        buckets[hour][consumer] += toMilliwattHours(shares[consumer], duration);
+    }
+
+    harvested[hour] += toMilliwattHours(solar, duration);
+
+    txTotal += toMilliwattHours(shares[EnergyTx], duration);
+    framesSent += frames;
+}
+
+void EnergyBudget::learn(const EnergyConsumer consumer, const float value) {
+    if (!hasLearnt[consumer]) {
+        power[consumer] = value;
+        hasLearnt[consumer] = true;
+        return;
+    }
+
+    power[consumer] += (value - power[consumer]) / ENERGY_BUDGET_LEARNING;
+}
+
+uint8_t EnergyBudget::bucket(const uint32_t time) {
+    const uint32_t hour = time / 3600000;
+    const uint8_t bucket = hour % ENERGY_BUDGET_HOURS;
+
+    if (hours[bucket] != hour) {
+        hours[bucket] = hour;
+        harvested[bucket] = 0;
+
+        for (auto &consumer : buckets[bucket]) {
+            consumer = 0;
+        }
+    }
+
+    return bucket;
+}
+
+uint32_t EnergyBudget::lastDay(const EnergyConsumer consumer) const {
+    const uint32_t hour = millis() / 3600000;
+    float total = 0;
+
+    for (uint8_t i = 0; i < ENERGY_BUDGET_HOURS; i++) {
+        if (hour - hours[i] < ENERGY_BUDGET_HOURS) {
+            total += buckets[i][consumer];
+        }
+    }
+
+    return static_cast<uint32_t>(total);
+}
+
+uint32_t EnergyBudget::lastDayConsumed() const {
+    uint32_t total = 0;
+
+    for (uint8_t consumer = 0; consumer < ENERGY_CONSUMER_COUNT; consumer++) {
+        total += lastDay(static_cast<EnergyConsumer>(consumer));
+    }
+
+    return total;
+}
+
+uint32_t EnergyBudget::lastDayHarvested() const {
+    const uint32_t hour = millis() / 3600000;
+    float total = 0;
+
+    for (uint8_t i = 0; i < ENERGY_BUDGET_HOURS; i++) {
+        if (hour - hours[i] < ENERGY_BUDGET_HOURS) {
+            total += harvested[i];
+        }
+    }
+
+    return static_cast<uint32_t>(total);
+}
@@ -1,5 +1,5 @@
 #include "GpioPin.h"
-#include "ArduinoLog.h"
+#include "Logging.h"
 
 GpioPin::GpioPin(const pin_size_t pin, const PinMode mode, const bool isAdc, const bool inverted, const bool state) : pin(pin), mode(mode),
     inverted(inverted), isAdc(isAdc) {
@@ -35,7 +35,7 @@ bool GpioPin::getState() const {
         result = !result;
     }
 
-    Log.traceln(F("[GPIO_%d] Get currentState %T"), pin, result);
+    LOG_TRACE(F("[GPIO_%d] Get currentState %T"), pin, result);
 
     return result;
 }
@@ -46,7 +46,7 @@ uint16_t GpioPin::getValue() const {
 
     const uint16_t value = analogRead(pin);
 
-    Log.traceln(F("[GPIO_%d] Get value %d"), pin, value);
+    LOG_TRACE(F("[GPIO_%d] Get value %d"), pin, value);
 
     return value;
 }
@@ -2,7 +2,7 @@
 #include "I2CSlave.h"
 #include "System.h"
 
-#include "ArduinoLog.h"
+#include "Logging.h"
 
 uint8_t I2CSlave::currentRegToRead = 0;
 System *I2CSlave::system = nullptr;
@@ -96,7 +96,7 @@ void I2CSlave::onRequest() {
             break;
     }
 
-    Log.infoln(F("[I2C_SLAVE] Send %d for register %x"), value, currentRegToRead);
+    LOG_TRACE(F("[I2C_SLAVE] Send %d for register %x"), value, currentRegToRead);
 
     Wire1.write(value >> 8 & 0xFF);
     Wire1.write(value & 0xFF);
@@ -104,11 +104,11 @@ void I2CSlave::onRequest() {
 
 
 void I2CSlave::onReceive(const int bytes) {
-    Log.traceln(F("[I2C_SLAVE] Receive %d bytes"), bytes);
+    LOG_TRACE(F("[I2C_SLAVE] Receive %d bytes"), bytes);
 
     if (bytes == 1) {
         currentRegToRead = Wire1.read();
-        Log.traceln(F("[I2C_SLAVE] Receive value %x to read"), currentRegToRead);
+        LOG_TRACE(F("[I2C_SLAVE] Receive value %x to read"), currentRegToRead);
 
         if (system->watchdogMeshtastic->enabled) {
             system->watchdogMeshtastic->feed();
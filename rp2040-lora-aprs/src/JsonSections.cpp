@@ -0,0 +1,58 @@
+#include "JsonSections.h"
+#include "Logging.h"
+
+typedef struct {
+    const char *name;
+    JsonSection section;
+} JsonSectionName;
+
+static const JsonSectionName names[] = {
+    {"errors", JsonErrors},
+    {"airtime", JsonAirtime},
+    {"txQueue", JsonTxQueue},
+    {"dupeCache", JsonDupeCache},
+    {"energyBudget", JsonEnergyBudget},
+    {"loadShedding", JsonLoadShedding},
+    {"sleep", JsonSleep},
+    {"radioCore", JsonRadioCore},
+    {"aprsHeardLog", JsonAprsHeardLog},
+    {"energy", JsonEnergy},
+    {"box", JsonBox},
+    {"weather", JsonWeather},
+    {"aprsSender", JsonAprsSender},
+    {"watchdog", JsonWatchdog},
+    {"runtime", JsonRuntime},
+    {"aprsReceived", JsonAprsReceived},
+    {"all", JsonAll},
+};
+
+bool JsonSections::parse(const char *list, uint32_t *sections) {
+    const char *start = list;
+    *sections = 0;
+
+    while (*list != '\0') {
+        const size_t length = strcspn(list, ",\r");
+        bool found = false;
+
+        for (const auto &name : names) {
+            if (strlen(name.name) == length && strncmp(name.name, list, length) == 0) {
+                *sections |= name.section;
+                found = true;
+                break;
+            }
+        }
+
+        if (!found && length > 0) {
+            Log.warningln(F("[JSON] Unknown section in %s"), start);
+            return false;
+        }
+
+        list += length;
+
+        if (*list != '\0') {
+            list++;
+        }
+    }
+
+    return *sections != 0;
+}
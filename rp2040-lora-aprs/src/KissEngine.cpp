@@ -0,0 +1,211 @@
+#include "KissEngine.h"
+#include "Ax25.h"
+#include "Logging.h"
+#include "System.h"
+
+KissEngine::KissEngine(System *system) : system(system) {
+}
+
+void KissEngine::begin() {
+    // Before begin(), the FIFO is allocated there
+    Serial2.setFIFOSize(KISS_RX_FIFO_SIZE);
+    Serial2.begin(115200);
+
+    reload();
+}
+
+void KissEngine::reload() {
+    monitor = system->settings.kiss.monitor;
+    signalReport = system->settings.kiss.signalReport;
+}
+
+void KissEngine::update() {
+    drain();
+
+    if (!Serial2.available()) {
+        return;
+    }
+
+    LOG_TRACE(F("Serial UART 1 incoming (KISS)"));
+
+    if (Serial2.overflow()) {
+        stats.overflows++;
+        Log.warningln(F("[SERIAL_KISS] UART FIFO overflow, bytes lost"));
+    }
+
+    // Bounded so the radio is not left waiting behind a long burst, the rest is for the next loop
+    for (uint16_t i = 0; i < KISS_FIFO_READ_MAX && Serial2.available(); i++) {
+        if (decoder.push(Serial2.read())) {
+            frameEnded();
+        }
+    }
+}
+
+void KissEngine::frameEnded() {
+    const uint8_t *frame = decoder.getFrame();
+    const size_t length = decoder.getLength();
+    const uint8_t type = frame[0];
+
+    if (decoder.isOverflow()) {
+        stats.dropped++;
+        Log.warningln(F("[SERIAL_KISS] Frame longer than %d bytes dropped"), KISS_FRAME_MAX - 1);
+        return;
+    }
+
+    if (type == 0xFF) {
+        LOG_TRACE(F("[SERIAL_KISS] Return, ignored"));
+        return;
+    }
+
+    if ((type >> 4) != 0) {
+        stats.dropped++;
+        Log.warningln(F("[SERIAL_KISS] Port %d unknown, frame dropped"), type >> 4);
+        return;
+    }
+
+    if ((type & 0x0F) != KissData) {
+        command(type & 0x0F, frame + 1, length - 1);
+        return;
+    }
+
+    if (length == 1) {
+        stats.dropped++;
+        Log.warningln(F("[SERIAL_KISS] Data frame without payload dropped"));
+        return;
+    }
+
+    Log.infoln(F("[SERIAL_KISS] Received %d of data from KISS OK"), length - 1);
+
+    system->gpioLed.setState(true);
+
+    if (system->communication.queueFrame(frame + 1, length - 1, TxPriorityKiss)) {
+        stats.frames++;
+    } else {
+        stats.dropped++;
+    }
+}
+
+void KissEngine::command(const uint8_t command, const uint8_t *data, const size_t size) {
+    stats.commands++;
+
+    if (command == KissSetHardware) {
+        setHardware(data, size);
+        return;
+    }
+
+    if (size < 1) {
+        Log.warningln(F("[SERIAL_KISS] Command %d without value"), command);
+        return;
+    }
+
+    switch (command) {
+        case KissTxDelay:
+            parameters.txDelay = data[0];
+            break;
+        case KissPersistence:
+            parameters.persistence = data[0];
+            break;
+        case KissSlotTime:
+            parameters.slotTime = data[0];
+            break;
+        case KissTxTail:
+            parameters.txTail = data[0];
+            break;
+        case KissFullDuplex:
+            parameters.fullDuplex = data[0] != 0;
+            break;
+        default:
+            Log.warningln(F("[SERIAL_KISS] Command %d unknown"), command);
+            return;
+    }
+
+    Log.infoln(F("[SERIAL_KISS] Command %d set to %d"), command, data[0]);
+}
+
+void KissEngine::setHardware(const uint8_t *data, const size_t size) {
+    // Vendor commands in text, "MONITOR 1" or "SIGNAL 0", only for this session
+    char text[16]{};
+    memcpy(text, data, size < sizeof(text) - 1 ? size : sizeof(text) - 1);
+
+    if (strncmp_P(text, PSTR("MONITOR "), 8) == 0) {
+        monitor = text[8] == '1';
+    } else if (strncmp_P(text, PSTR("SIGNAL "), 7) == 0) {
+        signalReport = text[7] == '1';
+    } else {
+        Log.warningln(F("[SERIAL_KISS] SetHardware %s not supported"), text);
+        return;
+    }
+
+    Log.infoln(F("[SERIAL_KISS] SetHardware %s"), text);
+}
+
+void KissEngine::received(const uint8_t *payload, size_t size, const bool isAprs, const float rssi, const float snr) {
+    if (isAprs && !monitor) {
+        return;
+    }
+
+    // Hosts expect AX.25, a text frame is converted and only sent raw if it has no AX.25 address
+    if (size >= 3 && payload[0] == '<' && payload[1] == 0xFF && payload[2] == 0x01) {
+        if (const size_t ax25Size = Ax25::encode(reinterpret_cast<const char *>(payload + 3), size - 3, ax25, sizeof(ax25)); ax25Size) {
+            payload = ax25;
+            size = ax25Size;
+        }
+    }
+
+    if (!send(KissData, payload, size) || !signalReport) {
+        return;
+    }
+
+    char report[32];
+    const int length = snprintf_P(report, sizeof(report), PSTR("RSSI:%.1f SNR:%.1f"), rssi, snr);
+
+    send(KissSetHardware, reinterpret_cast<const uint8_t *>(report), length);
+}
+
+bool KissEngine::send(const uint8_t command, const uint8_t *data, const size_t size) {
+    const size_t length = KissFrame::encode(command, data, size, encoded);
+    // One slot kept empty to tell a full ring from an empty one
+    const size_t free = KISS_TX_RING_SIZE - 1 - (txHead - txTail + KISS_TX_RING_SIZE) % KISS_TX_RING_SIZE;
+
+    if (length == 0 || length > free) {
+        stats.sentDropped++;
+        Log.warningln(F("[SERIAL_KISS] Frame of %d bytes dropped, %d bytes free for the host"), size, free);
+        return false;
+    }
+
+    // At most two copies when it wraps around the end of the ring
+    const size_t first = length < KISS_TX_RING_SIZE - txHead ? length : KISS_TX_RING_SIZE - txHead;
+    memcpy(txRing + txHead, encoded, first);
+    memcpy(txRing, encoded + first, length - first);
+    txHead = (txHead + length) % KISS_TX_RING_SIZE;
+
+    stats.sent++;
+
+    drain();
+
+    return true;
+}
+
+void KissEngine::drain() {
+    while (txTail != txHead && Serial2.availableForWrite() > 0) {
+        // Contiguous part of the ring, at most what the UART FIFO takes now
+        size_t length = (txHead > txTail ? txHead : KISS_TX_RING_SIZE) - txTail;
+        const auto room = static_cast<size_t>(Serial2.availableForWrite());
+
+        if (length > room) {
+            length = room;
+        }
+
+        const size_t written = Serial2.write(txRing + txTail, length);
+
+        if (written == 0) {
+            return;
+        }
+
+        txTail = (txTail + written) % KISS_TX_RING_SIZE;
+    }
+}
+
+bool KissEngine::shouldTransmit() const {
+    return parameters.persistence == 0xFF || static_cast<uint8_t>(random(256)) <= parameters.persistence;
+}
@@ -0,0 +1,77 @@
+#include "KissFrame.h"
+
+size_t KissFrame::encode(const uint8_t command, const uint8_t *data, const size_t size, uint8_t *out) {
+    if (size > KISS_FRAME_MAX - 1) {
+        return 0;
+    }
+
+    size_t position = 0;
+    out[position++] = KISS_FEND;
+
+    for (size_t i = 0; i <= size; i++) {
+        const uint8_t byte = i == 0 ? command : data[i - 1];
+
+        if (byte == KISS_FEND) {
+            out[position++] = KISS_FESC;
+            out[position++] = KISS_TFEND;
+        } else if (byte == KISS_FESC) {
+            out[position++] = KISS_FESC;
+            out[position++] = KISS_TFESC;
+        } else {
+            out[position++] = byte;
+        }
+    }
+
+    out[position++] = KISS_FEND;
+
+    return position;
+}
+
+bool KissFrameDecoder::push(const uint8_t byte) {
+    if (ended) { // The FEND which ended the previous frame starts this one
+        ended = false;
+        length = 0;
+        overflow = false;
+    }
+
+    if (byte == KISS_FEND) {
+        if (inFrame && length > 0) {
+            ended = true;
+            escaped = false;
+            return true;
+        }
+
+        inFrame = true;
+        length = 0;
+        escaped = false;
+        overflow = false;
+        return false;
+    }
+
+    if (!inFrame) { // Noise before the first FEND
+        return false;
+    }
+
+    uint8_t decoded = byte;
+
+    if (escaped) {
+        escaped = false;
+
+        if (byte == KISS_TFEND) {
+            decoded = KISS_FEND;
+        } else if (byte == KISS_TFESC) {
+            decoded = KISS_FESC;
+        }
+    } else if (byte == KISS_FESC) {
+        escaped = true;
+        return false;
+    }
+
+    if (length < sizeof(frame)) {
+        frame[length++] = decoded;
+    } else {
+        overflow = true;
+    }
+
+    return false;
+}
@@ -0,0 +1,80 @@
+#include "LoRaScheduler.h"
+
+int8_t LoRaScheduler::update(const SettingsLoRaScheduler &settings) {
+    int8_t wanted = profile;
+
+    if (held != LORA_PROFILE_AUTO) {
+        wanted = held;
+    } else if (!settings.enabled) {
+        wanted = LORA_PROFILE_APRS;
+    } else if (millis() - slotStart >= slot(profile, settings)) { // At once for a profile left out since its switch
+        // The APRS channel always has a slot, so there is one
+        for (uint8_t i = 1; i <= LORA_PROFILES; i++) {
+            const uint8_t candidate = (profile + i) % LORA_PROFILES;
+
+            if (slot(candidate, settings) > 0) {
+                wanted = static_cast<int8_t>(candidate);
+                break;
+            }
+        }
+
+        if (wanted == profile) { // Alone in the cycle, a new slot starts
+            switched(profile);
+        }
+    }
+
+    return wanted != profile ? wanted : LORA_PROFILE_AUTO;
+}
+
+void LoRaScheduler::switched(const uint8_t profile) {
+    const unsigned long now = millis();
+
+    stats[this->profile].time += now - slotStart;
+
+    this->profile = profile;
+    slotStart = now;
+}
+
+uint64_t LoRaScheduler::getTime(const uint8_t profile) const {
+    return stats[profile].time + (profile == this->profile ? millis() - slotStart : 0);
+}
+
+void LoRaScheduler::parameters(const uint8_t profile, const Settings &settings, SettingsLoRa *out) {
+    *out = settings.lora;
+
+    if (profile == LORA_PROFILE_APRS) {
+        return;
+    }
+
+    const SettingsLoRaProfile &selected = settings.loraScheduler.profiles[profile - 1];
+
+    out->frequency = selected.frequency;
+    out->bandwidth = selected.bandwidth;
+    out->spreadingFactor = selected.spreadingFactor;
+    out->codingRate = selected.codingRate;
+    out->outputPower = selected.outputPower;
+}
+
+const char *LoRaScheduler::getName(const uint8_t profile, const SettingsLoRaScheduler &settings) {
+    return profile == LORA_PROFILE_APRS ? "aprs" : settings.profiles[profile - 1].name;
+}
+
+int8_t LoRaScheduler::find(const char *name, const SettingsLoRaScheduler &settings) {
+    for (uint8_t profile = 0; profile < LORA_PROFILES; profile++) {
+        if (strlen(name) > 0 && strcasecmp(name, getName(profile, settings)) == 0) {
+            return static_cast<int8_t>(profile);
+        }
+    }
+
+    return LORA_PROFILE_AUTO;
+}
+
+uint32_t LoRaScheduler::slot(const uint8_t profile, const SettingsLoRaScheduler &settings) {
+    const uint32_t slot = profile == LORA_PROFILE_APRS ? settings.aprsSlot : settings.profiles[profile - 1].slot;
+
+    if (slot == 0 && profile != LORA_PROFILE_APRS) {
+        return 0;
+    }
+
+    return slot < LORA_SCHEDULER_SLOT_MIN ? LORA_SCHEDULER_SLOT_MIN : slot;
+}
@@ -0,0 +1,30 @@
+#include "Logging.h"
+
+void logHexDump(const char *tag, const uint8_t *data, const size_t size) {
+    static constexpr char hexadecimal[] = "0123456789ABCDEF";
+    char line[16 * 3 + 16 + 1];
+
+    for (size_t offset = 0; offset < size; offset += 16) {
+        char *cursor = line;
+
+        for (size_t i = offset; i < offset + 16; i++) {
+            if (i < size) {
+                *cursor++ = hexadecimal[data[i] >> 4];
+                *cursor++ = hexadecimal[data[i] & 0x0F];
+            } else {
+                *cursor++ = ' ';
+                *cursor++ = ' ';
+            }
+
+            *cursor++ = ' ';
+        }
+
+        for (size_t i = offset; i < offset + 16 && i < size; i++) {
+            *cursor++ = isprint(data[i]) ? static_cast<char>(data[i]) : '.';
+        }
+
+        *cursor = '\0';
+
+        Log.verboseln(F("%s %d: %s"), tag, offset, line);
+    }
+}
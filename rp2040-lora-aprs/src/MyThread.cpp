@@ -1,5 +1,5 @@
 #include "MyThread.h"
-#include "ArduinoLog.h"
+#include "Logging.h"
 
 MyThread::MyThread(System *system, const unsigned long interval, const char *name, const bool noLog, const bool enabled) : system(system), noLog(noLog) {
     this->enabled = enabled;
@@ -32,14 +32,17 @@ bool MyThread::begin() {
 }
 
 void MyThread::run() {
+    const uint32_t start = micros();
+
     if (!noLog) {
-        Log.traceln(F("[%s] Run"), ThreadName.c_str());
+        LOG_TRACE(F("[%s] Run"), ThreadName.c_str());
     }
 
     if (!initiated && !begin()) {
         runned();
         force = false;
         Log.errorln(F("[%s] Run KO"), ThreadName.c_str());
+        stats.add(micros() - start, THREAD_RUN_BUDGET * 1000);
         return;
     }
 
@@ -55,6 +58,8 @@ void MyThread::run() {
 
     runned();
     force = false;
+
+    stats.add(micros() - start, THREAD_RUN_BUDGET * 1000);
 }
 
 void MyThread::forceRun() {
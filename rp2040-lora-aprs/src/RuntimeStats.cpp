@@ -0,0 +1,54 @@
+#include "RuntimeStats.h"
+
+void RuntimeStats::add(const uint32_t duration, const uint32_t budget) {
+    uint8_t bucket = 0;
+    while (bucket < RUNTIME_STATS_BUCKETS - 1 && duration >= 2u << bucket) {
+        bucket++;
+    }
+
+    histogram[bucket]++;
+    count++;
+    total += duration;
+
+    if (duration < min) {
+        min = duration;
+    }
+
+    if (duration > max) {
+        max = duration;
+    }
+
+    if (budget > 0 && duration > budget) {
+        overruns++;
+    }
+}
+
+void RuntimeStats::reset() {
+    memset(histogram, 0, sizeof(histogram));
+    count = 0;
+    overruns = 0;
+    min = UINT32_MAX;
+    max = 0;
+    total = 0;
+}
+
+uint32_t RuntimeStats::percentile(const uint8_t percent) const {
+    if (count == 0) {
+        return 0;
+    }
+
+    const uint32_t rank = (static_cast<uint64_t>(count) * percent + 99) / 100;
+    uint32_t seen = 0;
+
+    for (uint8_t bucket = 0; bucket < RUNTIME_STATS_BUCKETS; bucket++) {
+        seen += histogram[bucket];
+
+        if (seen >= rank) {
+            // Bucket holds durations below 2^(bucket + 1), but never more than the real maximum
+            const uint32_t upper = (2u << bucket) - 1;
+            return upper < max ? upper : max;
+        }
+    }
+
+    return max;
+}
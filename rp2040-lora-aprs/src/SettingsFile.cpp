@@ -0,0 +1,190 @@
+#include <cstddef>
+
+#include "SettingsFile.h"
+#include "SettingsLegacy.h"
+#include "SettingsRegistry.h"
+#include "Logging.h"
+
+#define SETTINGS_FILE_MAGIC 0x47464E43 // CNFG
+#define SETTINGS_FILE_VERSION 1
+
+typedef struct {
+    uint16_t tag;
+    uint16_t length;
+} SettingsRecordHeader;
+
+uint32_t SettingsFile::lastCrc = 0;
+bool SettingsFile::isWritten = false;
+
+bool SettingsFile::load(Settings *settings) {
+    File file = LittleFS.open("/settings.dat", "r");
+    if (!file) {
+        return false;
+    }
+
+    SettingsFileHeader header{};
+    if (file.read(reinterpret_cast<uint8_t *>(&header), sizeof(header)) != sizeof(header) || header.magic != SETTINGS_FILE_MAGIC || header.version != SETTINGS_FILE_VERSION
+        || header.length != file.size() - sizeof(header)) {
+        file.close();
+        Log.errorln(F("[CONFIG] Settings file not compatible"));
+        return false;
+    }
+
+    // Checked before touching the settings, so a corrupted file leaves the defaults
+    uint8_t chunk[64];
+    uint32_t crc = 0;
+    for (uint32_t left = header.length; left > 0;) {
+        const size_t size = file.read(chunk, left < sizeof(chunk) ? left : sizeof(chunk));
+        if (size == 0) {
+            break;
+        }
+
+        crc = crc32(crc, chunk, size);
+        left -= size;
+    }
+
+    if (crc != header.crc) {
+        file.close();
+        Log.errorln(F("[CONFIG] Settings file corrupted, CRC %X instead of %X"), crc, header.crc);
+        return false;
+    }
+
+    file.seek(sizeof(header));
+
+    SettingsRecordHeader record{};
+    uint16_t skipped = 0;
+
+    for (uint16_t i = 0; i < header.fields && file.read(reinterpret_cast<uint8_t *>(&record), sizeof(record)) == sizeof(record); i++) {
+        if (const SettingDescriptor *setting = SettingsRegistry::findByTag(record.tag); setting != nullptr && setting->size == record.length) {
+            file.read(reinterpret_cast<uint8_t *>(settings) + setting->offset, setting->size);
+        } else {
+            LOG_TRACE(F("[CONFIG] Field %X of %d bytes unknown, default kept"), record.tag, record.length);
+            file.seek(record.length, SeekCur);
+            skipped++;
+        }
+    }
+
+    file.close();
+    lastCrc = header.crc;
+    isWritten = true;
+
+    Log.infoln(F("[CONFIG] %d fields read, %d skipped"), header.fields - skipped, skipped);
+
+    return true;
+}
+
+bool SettingsFile::save(const Settings *settings) {
+    uint16_t count = 0;
+    uint32_t length = 0;
+    const uint32_t crc = writeRecords(nullptr, settings, &count, &length);
+
+    if (isWritten && crc == lastCrc) {
+        LOG_TRACE(F("[CONFIG] Settings unchanged, not written"));
+        return true;
+    }
+
+    File file = LittleFS.open("/settings.tmp", "w");
+    if (!file) {
+        return false;
+    }
+
+    const SettingsFileHeader header = {SETTINGS_FILE_MAGIC, SETTINGS_FILE_VERSION, count, length, crc};
+    const bool ok = file.write(reinterpret_cast<const uint8_t *>(&header), sizeof(header)) == sizeof(header)
+        && writeRecords(&file, settings, &count, &length) == crc;
+    file.close();
+
+    if (!ok || !LittleFS.rename("/settings.tmp", "/settings.dat")) {
+        LittleFS.remove("/settings.tmp");
+        return false;
+    }
+
+    lastCrc = crc;
+    isWritten = true;
+
+    LOG_TRACE(F("[CONFIG] %d fields written in %d bytes"), count, sizeof(header) + length);
+
+    return true;
+}
+
+// Only counted and checksummed without file
+uint32_t SettingsFile::writeRecords(File *file, const Settings *settings, uint16_t *count, uint32_t *length) {
+    uint32_t crc = 0;
+    *count = 0;
+    *length = 0;
+
+    for (const SettingDescriptor *setting = SettingsRegistry::first(); setting != SettingsRegistry::end(); setting++) {
+        const uint8_t *value = reinterpret_cast<const uint8_t *>(settings) + setting->offset;
+
+        const SettingsRecordHeader record = {setting->tag, setting->size};
+        crc = crc32(crc, reinterpret_cast<const uint8_t *>(&record), sizeof(record));
+        crc = crc32(crc, value, setting->size);
+
+        if (file != nullptr && (file->write(reinterpret_cast<const uint8_t *>(&record), sizeof(record)) != sizeof(record) || file->write(value, setting->size) != setting->size)) {
+            return ~crc; // Never the expected one
+        }
+
+        (*count)++;
+        *length += sizeof(record) + setting->size;
+    }
+
+    return crc;
+}
+
+bool SettingsFile::migrate(Settings *settings) {
+    File file = LittleFS.open("/config.dat", "r");
+    if (!file) {
+        return false;
+    }
+
+    if (const size_t size = file.size(); size < offsetof(SettingsLegacy, reserved)) {
+        file.close();
+        Log.warningln(F("[CONFIG] Legacy config of %d bytes too short, not migrated"), size);
+        return false;
+    }
+
+    uint16_t migrated = 0;
+
+    for (const SettingDescriptor *setting = SettingsRegistry::first(); setting != SettingsRegistry::end(); setting++) {
+        if (setting->legacyOffset == SETTING_NO_LEGACY) {
+            continue;
+        }
+
+        if (!file.seek(setting->legacyOffset) || file.read(reinterpret_cast<uint8_t *>(settings) + setting->offset, setting->size) != setting->size) {
+            file.close();
+            Log.errorln(F("[CONFIG] Fail to migrate %s"), setting->key);
+            return false;
+        }
+
+        migrated++;
+    }
+
+    file.close();
+
+    Log.infoln(F("[CONFIG] %d fields migrated from legacy config"), migrated);
+
+    return true;
+}
+
+void SettingsFile::removeLegacy() {
+    if (LittleFS.exists("/config.dat") && LittleFS.exists("/settings.dat")) {
+        LittleFS.remove("/config.dat");
+        Log.infoln(F("[CONFIG] Legacy config removed"));
+    }
+}
+
+// Reflected, polynomial 0xEDB88320, a nibble at a time to keep the table small
+uint32_t SettingsFile::crc32(uint32_t crc, const uint8_t *data, const size_t size) {
+    static constexpr uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+
+    crc = ~crc;
+
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+        crc = table[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+
+    return ~crc;
+}
@@ -0,0 +1,644 @@
+#include <cstddef>
+
+#include "SettingsRegistry.h"
+#include "SettingsLegacy.h"
+#include "Logging.h"
+#include "System.h"
+#include "I2CSlave.h"
+#include "Threads/Energy/EnergyIna3221Thread.h"
+
+#define SETTING_INTERVAL_MIN 1000 // 1 second
+#define SETTING_INTERVAL_MAX 2592000000 // 30 days
+#define SETTING_PIN_MAX 29
+
+static bool restartLoRa(System *system) {
+    return system->communication.begin();
+}
+
+static bool restartI2CSlave(System *system) {
+    I2CSlave::end();
+    I2CSlave::begin(system);
+    return true;
+}
+
+static bool stopI2CSlave(System *system) {
+    I2CSlave::end();
+    return true;
+}
+
+static SettingApply applyReboot(System *system) {
+    system->planReboot();
+    return SettingNeedsReboot;
+}
+
+static SettingApply applyLoRa(System *system) {
+    return system->runOnRadioCore(restartLoRa) ? SettingApplied : SettingNotApplied;
+}
+
+static SettingApply applyLoRaTxEnabled(System *system) {
+    system->watchdogSlaveLoraTxThread->feed();
+    return SettingApplied;
+}
+
+static SettingApply applyLoRaWatchdogTx(System *system) {
+    system->watchdogSlaveLoraTxThread->enabled = system->settings.lora.watchdogTxEnabled;
+    system->watchdogSlaveLoraTxThread->setInterval(system->settings.lora.intervalTimeoutWatchdogTx);
+    return SettingApplied;
+}
+
+static SettingApply applyBeaconsEnabled(System *system) {
+    system->sendTelemetriesThread->enabled = system->settings.aprs.telemetryEnabled;
+    system->sendStatusThread->enabled = system->settings.aprs.statusEnabled;
+    system->sendPositionThread->enabled = system->settings.aprs.positionWeatherEnabled;
+    system->sendMeshtasticAprsThread->enabled = system->settings.meshtastic.aprsSendItemEnabled;
+    system->sendLinuxAprsThread->enabled = system->settings.linux.aprsSendItemEnabled;
+    return SettingApplied;
+}
+
+static SettingApply applyIntervals(System *system) {
+    system->loadSheddingThread->applyIntervals();
+    return SettingApplied;
+}
+
+static SettingApply applyMeshtasticWatchdog(System *system) {
+    system->watchdogMeshtastic->setInterval(system->settings.meshtastic.intervalTimeoutWatchdog);
+
+    if (system->watchdogMeshtastic->enabled != system->settings.meshtastic.watchdogEnabled) {
+        system->watchdogMeshtastic->enabled = system->settings.meshtastic.watchdogEnabled;
+
+        if (system->watchdogMeshtastic->enabled) {
+            system->watchdogMeshtastic->feed();
+        }
+    }
+
+    return SettingApplied;
+}
+
+static SettingApply applyMeshtasticPin(System *system) {
+    return system->watchdogMeshtastic->enabled ? applyReboot(system) : SettingApplied;
+}
+
+static SettingApply applyI2CSlave(System *system) {
+    system->runOnRadioCore(system->settings.meshtastic.i2cSlaveEnabled ? restartI2CSlave : stopI2CSlave);
+    return SettingApplied;
+}
+
+static SettingApply applyMpptWatchdog(System *system) {
+    system->watchdogSlaveMpptChgThread->setInterval(system->settings.mpptWatchdog.intervalFeed);
+
+    if (system->settings.mpptWatchdog.enabled) {
+        system->watchdogSlaveMpptChgThread->feed(); // Set timeout with feed
+    }
+
+    return SettingApplied;
+}
+
+static SettingApply applyWeatherInterval(System *system) {
+    system->weatherThread->setInterval(system->settings.weather.intervalCheck);
+    return SettingApplied;
+}
+
+static SettingApply applyBoxOpenedInterval(System *system) {
+    system->ldrBoxOpenedThread->setInterval(system->settings.boxOpened.intervalCheck);
+    return SettingApplied;
+}
+
+static SettingApply applyBoxOpenedPin(System *system) {
+    return system->settings.boxOpened.enabled ? applyReboot(system) : SettingApplied;
+}
+
+static SettingApply applyEnergyInterval(System *system) {
+    system->energyThread->setInterval(system->settings.energy.intervalCheck);
+    system->loadSheddingThread->setInterval(system->settings.energy.intervalCheck);
+    return SettingApplied;
+}
+
+static SettingApply applyInaChannels(System *system) {
+    if (system->settings.energy.type == ina) {
+        const auto energy = static_cast<EnergyIna3221Thread *>(system->energyThread); // NOLINT(*-pro-type-static-cast-downcast)
+        energy->channelBattery = system->settings.energy.inaChannelBattery;
+        energy->channelSolar = system->settings.energy.inaChannelSolar;
+    }
+
+    return SettingApplied;
+}
+
+static SettingApply applyMppt(System *system) {
+    return system->energyThread->begin() ? SettingApplied : SettingNotApplied;
+}
+
+static SettingApply applyLoadShedding(System *system) {
+    system->loadSheddingThread->forceRun();
+    return SettingApplied;
+}
+
+static bool reloadKiss(System *system) {
+    system->kiss.reload();
+    return true;
+}
+
+static SettingApply applyKiss(System *system) {
+    return system->runOnRadioCore(reloadKiss) ? SettingApplied : SettingNotApplied;
+}
+
+static bool restartLoRaScheduler(System *system) {
+    return system->communication.restartScheduler();
+}
+
+static SettingApply applyLoRaScheduler(System *system) {
+    return system->runOnRadioCore(restartLoRaScheduler) ? SettingApplied : SettingNotApplied;
+}
+
+static SettingApply applyLinuxWatchdog(System *system) {
+    system->watchdogLinux->setInterval(system->settings.linux.intervalTimeoutWatchdog);
+
+    if (system->watchdogLinux->enabled != system->settings.linux.watchdogEnabled) {
+        system->watchdogLinux->enabled = system->settings.linux.watchdogEnabled;
+
+        if (system->watchdogLinux->enabled) {
+            system->watchdogLinux->feed();
+        }
+    }
+
+    return SettingApplied;
+}
+
+static SettingApply applyLinuxPin(System *system) {
+    return system->watchdogLinux->enabled ? applyReboot(system) : SettingApplied;
+}
+
+static SettingApply applyRtcWakeUpPin(System *system) {
+    return system->settings.rtc.enabled ? applyReboot(system) : SettingApplied;
+}
+
+#define SETTING(key, tag, type, member, min, max, apply) \
+    {key, tag, type, offsetof(Settings, member), offsetof(SettingsLegacy, member), sizeof(static_cast<Settings *>(nullptr)->member), min, max, apply}
+// Field not in the raw config file
+#define SETTING_ADDED(key, tag, type, member, min, max, apply) \
+    {key, tag, type, offsetof(Settings, member), SETTING_NO_LEGACY, sizeof(static_cast<Settings *>(nullptr)->member), min, max, apply}
+
+// Sorted by key. Tag 0x020A was the three load shedding thresholds in one record, not to be reused.
+static constexpr SettingDescriptor descriptors[] = {
+    SETTING("aprs.altitude", 0x030A, SettingUnsigned, aprs.altitude, 0, UINT16_MAX, nullptr),
+    SETTING("aprs.call", 0x0301, SettingText, aprs.call, 0, 0, nullptr),
+    SETTING("aprs.comment", 0x0304, SettingText, aprs.comment, 0, 0, nullptr),
+    SETTING("aprs.destination", 0x0302, SettingText, aprs.destination, 0, 0, nullptr),
+    SETTING("aprs.digipeaterEnabled", 0x030B, SettingBool, aprs.digipeaterEnabled, 0, 1, nullptr),
+    SETTING("aprs.intervalPositionWeather", 0x0311, SettingUnsigned, aprs.intervalPositionWeather, SETTING_INTERVAL_MIN, SETTING_INTERVAL_MAX, applyIntervals),
+    SETTING("aprs.intervalStatus", 0x030F, SettingUnsigned, aprs.intervalStatus, SETTING_INTERVAL_MIN, SETTING_INTERVAL_MAX, applyIntervals),
+    SETTING("aprs.intervalTelemetry", 0x030D, SettingUnsigned, aprs.intervalTelemetry, SETTING_INTERVAL_MIN, SETTING_INTERVAL_MAX, applyIntervals),
+    SETTING("aprs.latitude", 0x0308, SettingDouble, aprs.latitude, -90, 90, nullptr),
+    SETTING("aprs.longitude", 0x0309, SettingDouble, aprs.longitude, -180, 180, nullptr),
+    SETTING("aprs.path", 0x0303, SettingText, aprs.path, 0, 0, nullptr),
+    SETTING("aprs.positionWeatherEnabled", 0x0310, SettingBool, aprs.positionWeatherEnabled, 0, 1, applyBeaconsEnabled),
+    SETTING("aprs.status", 0x0305, SettingText, aprs.status, 0, 0, nullptr),
+    SETTING("aprs.statusEnabled", 0x030E, SettingBool, aprs.statusEnabled, 0, 1, applyBeaconsEnabled),
+    SETTING("aprs.symbol", 0x0306, SettingChar, aprs.symbol, 0, 0, nullptr),
+    SETTING("aprs.symbolTable", 0x0307, SettingChar, aprs.symbolTable, 0, 0, nullptr),
+    SETTING("aprs.telemetryEnabled", 0x030C, SettingBool, aprs.telemetryEnabled, 0, 1, applyBeaconsEnabled),
+    SETTING("aprs.telemetryInPosition", 0x0312, SettingBool, aprs.telemetryInPosition, 0, 1, nullptr),
+    SETTING("aprs.telemetrySequenceNumber", 0x0313, SettingUnsigned, aprs.telemetrySequenceNumber, 0, UINT16_MAX, nullptr),
+    SETTING("boxOpened.enabled", 0x0701, SettingBool, boxOpened.enabled, 0, 1, nullptr),
+    SETTING("boxOpened.intervalCheck", 0x0702, SettingUnsigned, boxOpened.intervalCheck, SETTING_INTERVAL_MIN, SETTING_INTERVAL_MAX, applyBoxOpenedInterval),
+    SETTING("boxOpened.pin", 0x0703, SettingUnsigned, boxOpened.pin, 0, SETTING_PIN_MAX, applyBoxOpenedPin),
+    SETTING("energy.adcPin", 0x0203, SettingUnsigned, energy.adcPin, 0, SETTING_PIN_MAX, applyReboot),
+    SETTING("energy.inaChannelBattery", 0x0204, SettingUnsigned, energy.inaChannelBattery, INA3221_CH1, INA3221_CH3, applyInaChannels),
+    SETTING("energy.inaChannelSolar", 0x0205, SettingUnsigned, energy.inaChannelSolar, INA3221_CH1, INA3221_CH3, applyInaChannels),
+    SETTING("energy.intervalCheck", 0x0201, SettingUnsigned, energy.intervalCheck, SETTING_INTERVAL_MIN, SETTING_INTERVAL_MAX, applyEnergyInterval),
+    SETTING_ADDED("energy.lightSleep", 0x0208, SettingBool, energy.lightSleep, 0, 1, applyReboot),
+    SETTING_ADDED("energy.loadShedding", 0x0209, SettingBool, energy.loadShedding, 0, 1, applyLoadShedding),
+    SETTING("energy.mpptPowerOffVoltage", 0x0207, SettingUnsigned, energy.mpptPowerOffVoltage, 0, UINT16_MAX, applyMppt),
+    SETTING("energy.mpptPowerOnVoltage", 0x0206, SettingUnsigned, energy.mpptPowerOnVoltage, 0, UINT16_MAX, applyMppt),
+    SETTING_ADDED("energy.shedHysteresis", 0x020B, SettingUnsigned, energy.shedHysteresis, 0, 100, applyLoadShedding),
+    SETTING_ADDED("energy.shedTier1", 0x020C, SettingUnsigned, energy.shedThresholds[0], 0, 100, applyLoadShedding),
+    SETTING_ADDED("energy.shedTier2", 0x020D, SettingUnsigned, energy.shedThresholds[1], 0, 100, applyLoadShedding),
+    SETTING_ADDED("energy.shedTier3", 0x020E, SettingUnsigned, energy.shedThresholds[2], 0, 100, applyLoadShedding),
+    SETTING("energy.type", 0x0202, SettingUnsigned, energy.type, dummy, adc, applyReboot),
+    SETTING_ADDED("kiss.monitor", 0x0A01, SettingBool, kiss.monitor, 0, 1, applyKiss),
+    SETTING_ADDED("kiss.signalReport", 0x0A02, SettingBool, kiss.signalReport, 0, 1, applyKiss),
+    SETTING("linux.altitude", 0x080E, SettingUnsigned, linux.altitude, 0, UINT16_MAX, nullptr),
+    SETTING("linux.aprsSendItemEnabled", 0x0806, SettingBool, linux.aprsSendItemEnabled, 0, 1, applyBeaconsEnabled),
+    SETTING_ADDED("linux.binaryEnabled", 0x080F, SettingBool, linux.binaryEnabled, 0, 1, nullptr),
+    SETTING("linux.intervalSendItem", 0x0807, SettingUnsigned, linux.intervalSendItem, SETTING_INTERVAL_MIN, SETTING_INTERVAL_MAX, applyIntervals),
+    SETTING("linux.intervalTimeoutWatchdog", 0x0802, SettingUnsigned, linux.intervalTimeoutWatchdog, SETTING_INTERVAL_MIN, SETTING_INTERVAL_MAX, applyLinuxWatchdog),
+    SETTING("linux.itemComment", 0x0809, SettingText, linux.itemComment, 0, 0, nullptr),
+    SETTING("linux.itemName", 0x0808, SettingText, linux.itemName, 0, 0, nullptr),
+    SETTING("linux.latitude", 0x080C, SettingDouble, linux.latitude, -90, 90, nullptr),
+    SETTING("linux.longitude", 0x080D, SettingDouble, linux.longitude, -180, 180, nullptr),
+    SETTING("linux.nprPin", 0x0804, SettingUnsigned, linux.nprPin, 0, SETTING_PIN_MAX, applyReboot),
+    SETTING("linux.pin", 0x0803, SettingUnsigned, linux.pin, 0, SETTING_PIN_MAX, applyLinuxPin),
+    SETTING("linux.symbol", 0x080A, SettingChar, linux.symbol, 0, 0, nullptr),
+    SETTING("linux.symbolTable", 0x080B, SettingChar, linux.symbolTable, 0, 0, nullptr),
+    SETTING("linux.watchdogEnabled", 0x0801, SettingBool, linux.watchdogEnabled, 0, 1, applyLinuxWatchdog),
+    SETTING("linux.wifiPin", 0x0805, SettingUnsigned, linux.wifiPin, 0, SETTING_PIN_MAX, applyReboot),
+    SETTING("lora.bandwidth", 0x0102, SettingUnsigned, lora.bandwidth, 7, 500, applyLoRa),
+    SETTING("lora.codingRate", 0x0104, SettingUnsigned, lora.codingRate, 5, 8, applyLoRa),
+    SETTING_ADDED("lora.dutyCycle", 0x0109, SettingUnsigned, lora.dutyCycle, 0, 1000, nullptr),
+    SETTING_ADDED("lora.frameFormat", 0x010A, SettingUnsigned, lora.frameFormat, LoRaFrameText, LoRaFrameAx25, nullptr),
+    SETTING("lora.frequency", 0x0101, SettingFloat, lora.frequency, 150, 960, applyLoRa),
+    SETTING("lora.intervalTimeoutWatchdogTx", 0x0108, SettingUnsigned, lora.intervalTimeoutWatchdogTx, SETTING_INTERVAL_MIN, SETTING_INTERVAL_MAX, applyLoRaWatchdogTx),
+    SETTING("lora.outputPower", 0x0105, SettingUnsigned, lora.outputPower, 0, 22, applyLoRa),
+    SETTING("lora.spreadingFactor", 0x0103, SettingUnsigned, lora.spreadingFactor, 5, 12, applyLoRa),
+    SETTING("lora.txEnabled", 0x0106, SettingBool, lora.txEnabled, 0, 1, applyLoRaTxEnabled),
+    SETTING("lora.watchdogTxEnabled", 0x0107, SettingBool, lora.watchdogTxEnabled, 0, 1, applyLoRaWatchdogTx),
+    SETTING_ADDED("loraProfile1.bandwidth", 0x0B13, SettingUnsigned, loraScheduler.profiles[0].bandwidth, 7, 500, applyLoRaScheduler),
+    SETTING_ADDED("loraProfile1.codingRate", 0x0B15, SettingUnsigned, loraScheduler.profiles[0].codingRate, 5, 8, applyLoRaScheduler),
+    SETTING_ADDED("loraProfile1.frequency", 0x0B12, SettingFloat, loraScheduler.profiles[0].frequency, 150, 960, applyLoRaScheduler),
+    SETTING_ADDED("loraProfile1.name", 0x0B11, SettingText, loraScheduler.profiles[0].name, 0, 0, nullptr),
+    SETTING_ADDED("loraProfile1.outputPower", 0x0B16, SettingUnsigned, loraScheduler.profiles[0].outputPower, 0, 22, applyLoRaScheduler),
+    SETTING_ADDED("loraProfile1.slot", 0x0B17, SettingUnsigned, loraScheduler.profiles[0].slot, 0, SETTING_INTERVAL_MAX, applyLoRaScheduler),
+    SETTING_ADDED("loraProfile1.spreadingFactor", 0x0B14, SettingUnsigned, loraScheduler.profiles[0].spreadingFactor, 5, 12, applyLoRaScheduler),
+    SETTING_ADDED("loraProfile2.bandwidth", 0x0B23, SettingUnsigned, loraScheduler.profiles[1].bandwidth, 7, 500, applyLoRaScheduler),
+    SETTING_ADDED("loraProfile2.codingRate", 0x0B25, SettingUnsigned, loraScheduler.profiles[1].codingRate, 5, 8, applyLoRaScheduler),
+    SETTING_ADDED("loraProfile2.frequency", 0x0B22, SettingFloat, loraScheduler.profiles[1].frequency, 150, 960, applyLoRaScheduler),
+    SETTING_ADDED("loraProfile2.name", 0x0B21, SettingText, loraScheduler.profiles[1].name, 0, 0, nullptr),
+    SETTING_ADDED("loraProfile2.outputPower", 0x0B26, SettingUnsigned, loraScheduler.profiles[1].outputPower, 0, 22, applyLoRaScheduler),
+    SETTING_ADDED("loraProfile2.slot", 0x0B27, SettingUnsigned, loraScheduler.profiles[1].slot, 0, SETTING_INTERVAL_MAX, applyLoRaScheduler),
+    SETTING_ADDED("loraProfile2.spreadingFactor", 0x0B24, SettingUnsigned, loraScheduler.profiles[1].spreadingFactor, 5, 12, applyLoRaScheduler),
+    SETTING_ADDED("loraScheduler.aprsSlot", 0x0B02, SettingUnsigned, loraScheduler.aprsSlot, LORA_SCHEDULER_SLOT_MIN, SETTING_INTERVAL_MAX, applyLoRaScheduler),
+    SETTING_ADDED("loraScheduler.enabled", 0x0B01, SettingBool, loraScheduler.enabled, 0, 1, applyLoRaScheduler),
+    SETTING("meshtastic.altitude", 0x040E, SettingUnsigned, meshtastic.altitude, 0, UINT16_MAX, nullptr),
+    SETTING("meshtastic.aprsSendItemEnabled", 0x0406, SettingBool, meshtastic.aprsSendItemEnabled, 0, 1, applyBeaconsEnabled),
+    SETTING("meshtastic.i2cSlaveAddress", 0x0405, SettingHex, meshtastic.i2cSlaveAddress, 0x08, 0x77, applyI2CSlave),
+    SETTING("meshtastic.i2cSlaveEnabled", 0x0404, SettingBool, meshtastic.i2cSlaveEnabled, 0, 1, applyI2CSlave),
+    SETTING("meshtastic.intervalSendItem", 0x0407, SettingUnsigned, meshtastic.intervalSendItem, SETTING_INTERVAL_MIN, SETTING_INTERVAL_MAX, applyIntervals),
+    SETTING("meshtastic.intervalTimeoutWatchdog", 0x0402, SettingUnsigned, meshtastic.intervalTimeoutWatchdog, SETTING_INTERVAL_MIN, SETTING_INTERVAL_MAX, applyMeshtasticWatchdog),
+    SETTING("meshtastic.itemComment", 0x0409, SettingText, meshtastic.itemComment, 0, 0, nullptr),
+    SETTING("meshtastic.itemName", 0x0408, SettingText, meshtastic.itemName, 0, 0, nullptr),
+    SETTING("meshtastic.latitude", 0x040C, SettingDouble, meshtastic.latitude, -90, 90, nullptr),
+    SETTING("meshtastic.longitude", 0x040D, SettingDouble, meshtastic.longitude, -180, 180, nullptr),
+    SETTING("meshtastic.pin", 0x0403, SettingUnsigned, meshtastic.pin, 0, SETTING_PIN_MAX, applyMeshtasticPin),
+    SETTING("meshtastic.symbol", 0x040A, SettingChar, meshtastic.symbol, 0, 0, nullptr),
+    SETTING("meshtastic.symbolTable", 0x040B, SettingChar, meshtastic.symbolTable, 0, 0, nullptr),
+    SETTING("meshtastic.watchdogEnabled", 0x0401, SettingBool, meshtastic.watchdogEnabled, 0, 1, applyMeshtasticWatchdog),
+    SETTING("mpptWatchdog.enabled", 0x0501, SettingBool, mpptWatchdog.enabled, 0, 1, applyMpptWatchdog),
+    SETTING("mpptWatchdog.intervalFeed", 0x0503, SettingUnsigned, mpptWatchdog.intervalFeed, SETTING_INTERVAL_MIN, SETTING_INTERVAL_MAX, applyMpptWatchdog),
+    SETTING("mpptWatchdog.timeOff", 0x0504, SettingUnsigned, mpptWatchdog.timeOff, 1, UINT16_MAX, applyMpptWatchdog),
+    SETTING("mpptWatchdog.timeout", 0x0502, SettingUnsigned, mpptWatchdog.timeout, 1, UINT8_MAX, applyMpptWatchdog),
+    SETTING("rtc.enabled", 0x0901, SettingBool, rtc.enabled, 0, 1, nullptr),
+    SETTING("rtc.wakeUpPin", 0x0902, SettingUnsigned, rtc.wakeUpPin, 0, SETTING_PIN_MAX, applyRtcWakeUpPin),
+    SETTING("useInternalWatchdog", 0x0001, SettingBool, useInternalWatchdog, 0, 1, applyReboot),
+    SETTING("useSlowClock", 0x0002, SettingBool, useSlowClock, 0, 1, applyReboot),
+    SETTING("weather.enabled", 0x0601, SettingBool, weather.enabled, 0, 1, nullptr),
+    SETTING("weather.intervalCheck", 0x0602, SettingUnsigned, weather.intervalCheck, SETTING_INTERVAL_MIN, SETTING_INTERVAL_MAX, applyWeatherInterval),
+};
+
+static constexpr size_t settingsCount = sizeof(descriptors) / sizeof(descriptors[0]);
+
+static constexpr int compareKeys(const char *a, const char *b) {
+    while (*a != '\0' && *a == *b) {
+        a++;
+        b++;
+    }
+
+    return static_cast<unsigned char>(*a) - static_cast<unsigned char>(*b);
+}
+
+static constexpr bool isValid() {
+    for (size_t i = 0; i < settingsCount; i++) {
+        if (i > 0 && compareKeys(descriptors[i - 1].key, descriptors[i].key) >= 0) {
+            return false;
+        }
+
+        for (size_t j = i + 1; j < settingsCount; j++) {
+            if (descriptors[i].tag == descriptors[j].tag) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+static constexpr uint16_t fieldSizeMax() {
+    uint16_t max = 0;
+
+    for (const auto &setting : descriptors) {
+        if (setting.size > max) {
+            max = setting.size;
+        }
+    }
+
+    return max;
+}
+
+static_assert(isValid(), "Keys must be sorted and unique, tags unique");
+static_assert(LORA_PROFILES == 3, "One group of loraProfileN settings per profile of the scheduler");
+static_assert(sizeof(Settings) <= 0xFFFF && sizeof(SettingsLegacy) < SETTING_NO_LEGACY, "Offsets are on uint16_t");
+
+const SettingDescriptor *SettingsRegistry::find(const char *key) {
+    return find(key, strlen(key));
+}
+
+const SettingDescriptor *SettingsRegistry::find(const char *key, const size_t length) {
+    size_t low = 0;
+    size_t high = settingsCount;
+
+    while (low < high) {
+        const size_t middle = (low + high) / 2;
+        int comparison = strncmp(key, descriptors[middle].key, length);
+
+        if (comparison == 0 && descriptors[middle].key[length] != '\0') { // A prefix of the key is before it
+            comparison = -1;
+        }
+
+        if (comparison == 0) {
+            return &descriptors[middle];
+        }
+
+        if (comparison < 0) {
+            high = middle;
+        } else {
+            low = middle + 1;
+        }
+    }
+
+    return nullptr;
+}
+
+const SettingDescriptor *SettingsRegistry::findByTag(const uint16_t tag) {
+    for (const auto &setting : descriptors) {
+        if (setting.tag == tag) {
+            return &setting;
+        }
+    }
+
+    return nullptr;
+}
+
+const SettingDescriptor *SettingsRegistry::first() {
+    return descriptors;
+}
+
+const SettingDescriptor *SettingsRegistry::end() {
+    return descriptors + settingsCount;
+}
+
+// Written by the radio core while the main core waits for it, as it reads the settings too (call, path, lora.*)
+static const SettingDescriptor *pendingSetting = nullptr;
+static const uint8_t *pendingField = nullptr;
+static const Settings *pendingStaged = nullptr;
+
+static bool copyPendingField(System *system) {
+    memcpy(reinterpret_cast<uint8_t *>(&system->settings) + pendingSetting->offset, pendingField, pendingSetting->size);
+    return true;
+}
+
+static bool copyPendingStaged(System *system) {
+    for (const auto &setting : descriptors) {
+        memcpy(reinterpret_cast<uint8_t *>(&system->settings) + setting.offset, reinterpret_cast<const uint8_t *>(pendingStaged) + setting.offset, setting.size);
+    }
+
+    return true;
+}
+
+static bool parseField(const SettingDescriptor *setting, uint8_t *field, const char *value) {
+    char *end = nullptr;
+
+    switch (setting->type) {
+        case SettingBool:
+            field[0] = value[0] == '1';
+            return true;
+        case SettingChar:
+            field[0] = value[0];
+            return true;
+        case SettingText:
+            if (strlen(value) >= setting->size) {
+                return false;
+            }
+
+            strcpy(reinterpret_cast<char *>(field), value);
+            return true;
+        case SettingUnsigned:
+        case SettingHex: {
+            const uint64_t number = strtoull(value, &end, 0);
+            if (end == value || *end != '\0' || !(number >= setting->min && number <= setting->max)) {
+                return false;
+            }
+
+            memcpy(field, &number, setting->size); // Little endian, the low bytes
+            return true;
+        }
+        case SettingFloat: {
+            const float number = strtof(value, &end);
+            if (end == value || *end != '\0' || !(number >= setting->min && number <= setting->max)) {
+                return false;
+            }
+
+            memcpy(field, &number, sizeof(number));
+            return true;
+        }
+        case SettingDouble: {
+            const double number = strtod(value, &end);
+            if (end == value || *end != '\0' || !(number >= setting->min && number <= setting->max)) {
+                return false;
+            }
+
+            memcpy(field, &number, sizeof(number));
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SettingsRegistry::parse(const SettingDescriptor *setting, Settings *settings, const char *value) {
+    return parseField(setting, reinterpret_cast<uint8_t *>(settings) + setting->offset, value);
+}
+
+bool SettingsRegistry::set(System *system, const SettingDescriptor *setting, const char *value) {
+    uint8_t field[fieldSizeMax()];
+    memcpy(field, reinterpret_cast<const uint8_t *>(&system->settings) + setting->offset, setting->size);
+
+    if (!parseField(setting, field, value)) {
+        return false;
+    }
+
+    pendingSetting = setting;
+    pendingField = field;
+
+    return system->runOnRadioCore(copyPendingField);
+}
+
+void SettingsRegistry::format(const SettingDescriptor *setting, const Settings *settings, char *buffer, const size_t size) {
+    const uint8_t *field = reinterpret_cast<const uint8_t *>(settings) + setting->offset;
+
+    switch (setting->type) {
+        case SettingBool:
+            snprintf_P(buffer, size, PSTR("%d"), field[0]);
+            break;
+        case SettingChar:
+            snprintf_P(buffer, size, PSTR("%c"), field[0]);
+            break;
+        case SettingText:
+            snprintf_P(buffer, size, PSTR("%.*s"), setting->size, reinterpret_cast<const char *>(field));
+            break;
+        case SettingUnsigned:
+        case SettingHex: {
+            uint64_t number = 0;
+            memcpy(&number, field, setting->size);
+            snprintf_P(buffer, size, setting->type == SettingHex ? PSTR("0x%llx") : PSTR("%llu"), static_cast<unsigned long long>(number));
+            break;
+        }
+        case SettingFloat: {
+            float number;
+            memcpy(&number, field, sizeof(number));
+            snprintf_P(buffer, size, PSTR("%f"), number);
+            break;
+        }
+        case SettingDouble: {
+            double number;
+            memcpy(&number, field, sizeof(number));
+            snprintf_P(buffer, size, PSTR("%lf"), number);
+            break;
+        }
+    }
+}
+
+void SettingsRegistry::print(const Settings *settings) {
+    char value[SETTING_VALUE_LENGTH];
+
+    for (const auto &setting : descriptors) {
+        format(&setting, settings, value, sizeof(value));
+        LOG_TRACE(F("[CONFIG] %s = %s"), setting.key, value);
+    }
+}
+
+void SettingsRegistry::writeJson(JsonWriter *writer, const Settings *settings) {
+    char value[SETTING_VALUE_LENGTH];
+
+    writer->beginObject();
+
+    for (const auto &setting : descriptors) {
+        const auto key = reinterpret_cast<const __FlashStringHelper *>(setting.key);
+        const uint8_t *field = reinterpret_cast<const uint8_t *>(settings) + setting.offset;
+
+        switch (setting.type) {
+            case SettingBool:
+                writer->property(key, field[0] != 0);
+                break;
+            case SettingUnsigned: {
+                uint64_t number = 0;
+                memcpy(&number, field, setting.size);
+                writer->property(key, number);
+                break;
+            }
+            default: // As printed by get, the other types would lose their format or precision
+                format(&setting, settings, value, sizeof(value));
+                writer->property(key, value);
+                break;
+        }
+    }
+
+    writer->endObject();
+}
+
+void SettingsRegistry::writeText(Print *out, const Settings *settings) {
+    char value[SETTING_VALUE_LENGTH];
+
+    for (const auto &setting : descriptors) {
+        out->print(setting.key);
+        out->print(' ');
+
+        if (setting.type != SettingText && setting.type != SettingChar) {
+            format(&setting, settings, value, sizeof(value));
+            out->println(value);
+            continue;
+        }
+
+        // From the field, as a path can be longer than a printed value
+        const char *text = reinterpret_cast<const char *>(settings) + setting.offset;
+        out->print('"');
+
+        for (size_t i = 0; i < setting.size && text[i] != '\0'; i++) {
+            if (text[i] == '"' || text[i] == '\\') {
+                out->print('\\');
+            }
+
+            out->print(text[i]);
+        }
+
+        out->println('"');
+    }
+}
+
+const SettingDescriptor *SettingsRegistry::parseLine(Settings *settings, char *line) {
+    char *value = strchr(line, ' ');
+    if (value == nullptr) {
+        return nullptr;
+    }
+
+    *value++ = '\0';
+
+    if (*value == '"') {
+        // Unescaped in place
+        char *to = ++value;
+        const char *from = value;
+
+        while (*from != '\0' && *from != '"') {
+            if (*from == '\\' && from[1] != '\0') {
+                from++;
+            }
+
+            *to++ = *from++;
+        }
+
+        *to = '\0';
+    } else {
+        value[strcspn(value, "\r")] = '\0';
+    }
+
+    const SettingDescriptor *setting = find(line);
+    if (setting == nullptr || !parse(setting, settings, value)) {
+        return nullptr;
+    }
+
+    return setting;
+}
+
+SettingApply SettingsRegistry::commit(System *system, const Settings *staged, uint16_t *changed) {
+    SettingApply (*toApply[settingsCount])(System *system){};
+    size_t toApplyCount = 0;
+    *changed = 0;
+
+    for (const auto &setting : descriptors) {
+        const uint8_t *field = reinterpret_cast<const uint8_t *>(&system->settings) + setting.offset;
+        const uint8_t *stagedField = reinterpret_cast<const uint8_t *>(staged) + setting.offset;
+
+        if (memcmp(field, stagedField, setting.size) == 0) {
+            continue;
+        }
+
+        (*changed)++;
+
+        if (setting.apply == nullptr) {
+            continue;
+        }
+
+        bool isQueued = false;
+        for (size_t i = 0; i < toApplyCount && !isQueued; i++) {
+            isQueued = toApply[i] == setting.apply;
+        }
+
+        if (!isQueued) {
+            toApply[toApplyCount++] = setting.apply;
+        }
+    }
+
+    if (*changed > 0) {
+        pendingStaged = staged;
+        system->runOnRadioCore(copyPendingStaged);
+    }
+
+    SettingApply result = SettingApplied;
+
+    for (size_t i = 0; i < toApplyCount; i++) {
+        if (const SettingApply applied = toApply[i](system); applied == SettingNotApplied) {
+            result = SettingNotApplied;
+        } else if (applied == SettingNeedsReboot && result == SettingApplied) {
+            result = SettingNeedsReboot;
+        }
+    }
+
+    return result;
+}
@@ -1,11 +1,13 @@
 #include <hardware/rtc.h>
 #include <LittleFS.h>
 
-#include "ArduinoLog.h"
+#include "Logging.h"
 #include "System.h"
 
 #include <hardware/pll.h>
+#include <hardware/sync.h>
 #include <hardware/vreg.h>
+#include <pico/time.h>
 
 #include "Threads/Energy/EnergyMpptChgThread.h"
 #include "Threads/Energy/EnergyIna3221Thread.h"
@@ -14,12 +16,15 @@
 
 #include "Threads/BlinkerThread.h"
 #include "Threads/LdrBoxOpenedThread.h"
+#include "SettingsRegistry.h"
 
 #include "I2CSlave.h"
 #include "utils.h"
 #include "PicoSleep.h"
 
-System::System() : communication(this), command(this) {
+volatile bool System::hasRtcWakeUp = false;
+
+System::System() : communication(this), command(this), binaryLink(this), kiss(this) {
     timerReboot.pause();
     timerDfu.pause();
 }
@@ -39,6 +44,9 @@ bool System::begin() {
         ledBlink(3, 2000);
     }
 
+    aprsHeard.begin();
+    SettingsFile::removeLegacy(); // Once the heard list had a chance to migrate from it too
+
 //    setDefaultSettings();
 //    saveSettings();
 
@@ -59,6 +67,7 @@ bool System::begin() {
 
     if (settings.rtc.enabled) {
         gpiosPin[gpioI++] = new GpioPin(settings.rtc.wakeUpPin, INPUT);
+        attachInterrupt(settings.rtc.wakeUpPin, onRtcWakeUp, FALLING); // DS3231 INT is active low
         const auto now = RTClib::now();
         if (now.year() >= 2025) {
             setTimeToInternalRtc(now.unixtime());
@@ -67,8 +76,6 @@ bool System::begin() {
         }
     }
 
-    communication.begin();
-
     ldrBoxOpenedThread = new LdrBoxOpenedThread(this);
     // threadController.add(ldrBoxOpenedThread);
 
@@ -91,10 +98,6 @@ bool System::begin() {
     weatherThread = new WeatherThread(this);
     threadController.add(weatherThread);
 
-    if (settings.meshtastic.i2cSlaveEnabled) {
-        I2CSlave::begin(this);
-    }
-
     watchdogSlaveMpptChgThread = new WatchdogSlaveMpptChgThread(this);
     if (settings.energy.type == mpptchg) {
         threadController.add(watchdogSlaveMpptChgThread);
@@ -131,6 +134,9 @@ bool System::begin() {
     sendLinuxAprsThread = new LinuxSendAprsThread(this);
     threadController.add(sendLinuxAprsThread);
 
+    loadSheddingThread = new LoadSheddingThread(this);
+    threadController.add(loadSheddingThread);
+
     for(int i = 0; i < MAX_THREADS ; i++) {
         if (const auto thread = static_cast<MyThread *>(threadController.get(i)); thread != nullptr) { // NOLINT(*-pro-type-static-cast-downcast)
             if (!thread->enabled) {
@@ -148,27 +154,93 @@ bool System::begin() {
         }
     }
 
+    if (settings.energy.lightSleep) {
+        lightSleepGateClocks(isInDebugMode());
+        lightSleepEnableCore();
+        Log.infoln(F("[SYSTEM] Light sleep enabled"));
+    }
+
     Log.infoln(F("[SYSTEM] Started"));
 
+    lastRadioCoreProgress = millis();
+    started.store(true, std::memory_order_release);
+
     return true;
 }
 
+void System::beginRadio() {
+    kiss.begin();
+
+    if (settings.energy.lightSleep) {
+        lightSleepEnableCore();
+    }
+
+    communication.begin();
+
+    if (settings.meshtastic.i2cSlaveEnabled) {
+        I2CSlave::begin(this);
+    }
+
+    Log.infoln(F("[SYSTEM] Radio core started"));
+}
+
+void System::loopRadio() {
+    if (const auto function = radioCoreFunction.load(std::memory_order_acquire); function != nullptr) {
+        radioCoreResult = function(this);
+        radioCoreFunction.store(nullptr, std::memory_order_release);
+        __sev();
+    }
+
+    if (Serial2.available()) {
+        kissReceived.store(true, std::memory_order_relaxed);
+    }
+
+    kiss.update();
+    communication.update();
+
+    radioCoreLoops.store(radioCoreLoops.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    waitNextRadioEvent();
+}
+
+bool System::runOnRadioCore(bool (*function)(System *system)) {
+    radioCoreFunction.store(function, std::memory_order_release);
+    __sev();
+
+    while (radioCoreFunction.load(std::memory_order_acquire) != nullptr) {
+        best_effort_wfe_or_timeout(make_timeout_time_ms(1));
+    }
+
+    return radioCoreResult;
+}
+
 void System::loop() {
+    const uint32_t loopStart = micros();
+
+    if (lastLoopStart != 0) {
+        loopPeriodStats.add(loopStart - lastLoopStart);
+    }
+    lastLoopStart = loopStart;
+
+    if (hasRtcWakeUp) {
+        hasRtcWakeUp = false;
+        rtcWakeUps++;
+        LOG_TRACE(F("[RTC] Wake up"));
+    }
+
+    // The KISS host runs on the Linux board too
+    if (kissReceived.exchange(false, std::memory_order_relaxed) && watchdogLinux->enabled) {
+        watchdogLinux->feed();
+    }
+
     Stream *streamReceived = nullptr;
 
     if (Serial.available()) {
         streamReceived = &Serial;
-        Log.traceln(F("Serial USB incoming"));
+        LOG_TRACE(F("Serial USB incoming"));
     } else if (Serial1.available()) {
         streamReceived = &Serial1;
-        Log.traceln(F("Serial UART 0 incoming (Linux)"));
-
-        if (watchdogLinux->enabled) {
-            watchdogLinux->feed();
-        }
-    } else if (Serial2.available()) {
-        streamReceived = &Serial2;
-        Log.traceln(F("Serial UART 1 incoming (KISS)"));
+        LOG_TRACE(F("Serial UART 0 incoming (Linux)"));
 
         if (watchdogLinux->enabled) {
             watchdogLinux->feed();
@@ -178,36 +250,21 @@ void System::loop() {
     if (streamReceived != nullptr) {
         gpioLed.setState(true);
 
-        if (streamReceived == &Serial2) {
-            kissPacket = kiss_new_packet(buffer, BUFFER_LENGTH);
-            size_t bytesRead = 0;
-            while (streamReceived->available()) {
-                buffer[bytesRead++] = streamReceived->read();
+        const size_t lineLength = streamReceived->readBytesUntil('\n', bufferText, BUFFER_LENGTH - 5);
+        bufferText[lineLength] = '\0';
 
-                size_t bytesConsumed = kiss_decode_packet(&kissPacket, buffer, bytesRead);
+        LOG_TRACE(F("[SERIAL] Received %s"), bufferText);
 
-                bytesRead -= bytesConsumed;
-
-                if (kissPacket.complete_packet) {
-                    Log.infoln(F("[SERIAL_KISS] Received %d of data from KISS OK"), kissPacket.data_length);
-                    communication.sendRaw(kissPacket.data, kissPacket.data_length);
-                }
-            }
-        } else {
-            const size_t lineLength = streamReceived->readBytesUntil('\n', bufferText, BUFFER_LENGTH - 5);
-            bufferText[lineLength] = '\0';
-
-            Log.traceln(F("[SERIAL] Received %s"), bufferText);
-
-            command.processCommand(streamReceived, bufferText);
-        }
+        command.processCommand(streamReceived, bufferText);
 
         streamReceived->flush();
     } else {
         threadController.run();
     }
 
-    communication.update();
+    communication.processReceived();
+    aprsHeard.flush();
+    binaryLink.loop();
 
     if (timerPrintJson.hasExpired()) {
         printJson(true);
@@ -215,6 +272,7 @@ void System::loop() {
     }
 
     if (timerReboot.hasExpired()) {
+        aprsHeard.flush(true);
         rp2040.reboot();
         return;
     }
@@ -224,13 +282,81 @@ void System::loop() {
             watchdogSlaveMpptChgThread->setManagedByUser(TIME_SET_MPPT_WATCHDOG_DFU);
         }
 
+        aprsHeard.flush(true);
+
         rp2040.rebootToBootloader();
         return;
     }
 
-    delay(10);
+    loopStats.add(micros() - loopStart, THREAD_RUN_BUDGET * 1000);
+
+    waitNextEvent();
+
+    if (isRadioCoreAlive()) {
+        rp2040.wdt_reset();
+    }
+}
+
+bool System::isRadioCoreAlive() {
+    if (const uint32_t loops = getRadioCoreLoops(); loops != lastRadioCoreLoops) {
+        lastRadioCoreLoops = loops;
+        lastRadioCoreProgress = millis();
+        return true;
+    }
+
+    if (millis() - lastRadioCoreProgress < TIME_RADIO_CORE_STALLED) {
+        return true;
+    }
+
+    Log.errorln(F("[SYSTEM] Radio core stalled for %dms"), millis() - lastRadioCoreProgress);
+
+    return false;
+}
+
+uint32_t System::timeBeforeNextEvent() {
+    uint32_t wait = LOOP_MAX_WAIT;
+
+    for (int i = 0; i < MAX_THREADS; i++) {
+        if (const auto thread = static_cast<MyThread *>(threadController.get(i)); thread != nullptr && thread->enabled && thread->timeBeforeRun() < wait) { // NOLINT(*-pro-type-static-cast-downcast)
+            wait = thread->timeBeforeRun();
+        }
+    }
+
+    return wait;
+}
+
+void System::onRtcWakeUp() {
+    hasRtcWakeUp = true;
+}
+
+bool System::hasPendingEvent() {
+    return hasRtcWakeUp || communication.hasReceived() || Serial.available() || Serial1.available();
+}
+
+void System::waitNextEvent() {
+    const uint32_t waitStart = micros();
+    const absolute_time_t deadline = make_timeout_time_ms(timeBeforeNextEvent());
+
+    // UART0, USB and DS3231 interrupts and the radio core events wake the core up, go back to the loop only if there is something to handle.
+    // With light sleep, the clocks are gated once the radio core waits too
+    while (!hasPendingEvent() && !best_effort_wfe_or_timeout(deadline)) {
+    }
+
+    timeWaiting += micros() - waitStart;
+}
 
-    rp2040.wdt_reset();
+bool System::hasPendingRadioEvent() {
+    return communication.hasPendingWork() || kiss.hasPendingWork() || radioCoreFunction.load(std::memory_order_acquire) != nullptr;
+}
+
+void System::waitNextRadioEvent() {
+    // The TX state machine has its own timeouts and retries deferred frames
+    const uint32_t wait = communication.isTransmitting() || !communication.txQueue.isEmpty() ? LOOP_BUSY_WAIT : LOOP_MAX_WAIT;
+    const absolute_time_t deadline = make_timeout_time_ms(wait);
+
+    // DIO1, UART1 and I2C interrupts are on this core, the main core signals its frames and requests with an event
+    while (!hasPendingRadioEvent() && !best_effort_wfe_or_timeout(deadline)) {
+    }
 }
 
 void System::setTimeToInternalRtc(const time_t epoch) {
@@ -242,66 +368,36 @@ void System::setTimeToInternalRtc(const time_t epoch) {
 }
 
 bool System::loadSettings() {
-    File file = LittleFS.open("/config.dat", "r");
-    if (!file) {
-        Log.warningln(F("[CONFIG] Fail to open, we create it"));
+    setDefaultSettings();
 
-        setDefaultSettings();
+    if (SettingsFile::load(&settings)) {
+        Log.infoln(F("[CONFIG] Read correctly"));
 
-        return saveSettings();
-    }
-
-    file.read(reinterpret_cast<uint8_t *>(&settings), sizeof(Settings));
-    file.close();
+        printSettings();
 
-    Log.infoln(F("[CONFIG] Read correctly"));
+        return true;
+    }
 
-    printSettings();
+    if (!SettingsFile::migrate(&settings)) {
+        Log.warningln(F("[CONFIG] Fail to open, we create it"));
+        setDefaultSettings();
+    }
 
-    return true;
+    return saveSettings();
 }
 
 bool System::saveSettings() {
-    File file = LittleFS.open("/config.dat", "w");
-    if (!file) {
+    if (!SettingsFile::save(&settings)) {
         Log.errorln(F("[CONFIG] Fail to save, we use the default one"));
         printSettings();
         return false;
     }
 
-    file.write(reinterpret_cast<uint8_t *>(&settings), sizeof(Settings));
-    file.close();
-
     Log.infoln(F("[CONFIG] Save to FS"));
 
     return true;
 }
 
-void System::addAprsFrameReceivedToHistory(const AprsPacketLite *packet, const float snr, const float rssi) {
-    uint8_t frameIndex = 0;
-
-    for (const auto oldFrame : settings.aprsCallsignsHeard) {
-        if (strcmp(oldFrame.callsign, packet->source) == 0 || strlen(oldFrame.callsign) == 0) {
-            break;
-        }
-
-        frameIndex++;
-    }
-
-    lastAprsHeard = &settings.aprsCallsignsHeard[frameIndex];
-
-    lastAprsHeard->time = getDateTime().unixtime();
-    lastAprsHeard->snr = snr;
-    lastAprsHeard->rssi = rssi;
-    lastAprsHeard->count++;
-    lastAprsHeard->digipeaterCount = packet->digipeaterCount;
-    strcpy(lastAprsHeard->callsign, packet->source);
-    strcpy(lastAprsHeard->content, packet->raw);
-    strcpy(lastAprsHeard->digipeaterCallsign, packet->lastDigipeaterCallsignInPath);
-
-    saveSettings();
-}
-
 bool System::resetSettings() {
     if (!LittleFS.format()) {
         Log.errorln(F("[CONFIG] Fail to format"));
@@ -311,6 +407,7 @@ bool System::resetSettings() {
     Log.infoln(F("[CONFIG] Deleted"));
 
     loadSettings();
+    aprsHeard.clear();
 
     return true;
 }
@@ -327,6 +424,8 @@ void System::setDefaultSettings() {
     settings.lora.txEnabled = true;
     settings.lora.watchdogTxEnabled = true;
     settings.lora.intervalTimeoutWatchdogTx = 7200000; // 2 hours
+    settings.lora.dutyCycle = 0; // 100 for 10% on 869.525 MHz
+    settings.lora.frameFormat = LoRaFrameText;
 
     strcpy_P(settings.aprs.call, PSTR("F4HVV-15"));
     strcpy_P(settings.aprs.destination, PSTR("APLV1"));
@@ -371,6 +470,12 @@ void System::setDefaultSettings() {
     settings.energy.type = mpptchg;
     settings.energy.intervalCheck = 60000; // 60 seconds
     settings.energy.mpptPowerOffVoltage = 11100;
+    settings.energy.lightSleep = false;
+    settings.energy.loadShedding = false; // Tier 2 powers off the Linux board, NPR and WiFi, only when asked
+    settings.energy.shedThresholds[0] = 40;
+    settings.energy.shedThresholds[1] = 25;
+    settings.energy.shedThresholds[2] = 10;
+    settings.energy.shedHysteresis = 5;
     settings.energy.mpptPowerOnVoltage = 11300;
 
     settings.weather.enabled = true;
@@ -390,6 +495,26 @@ void System::setDefaultSettings() {
     settings.linux.latitude = 45.325786;
     settings.linux.longitude = 5.636669;
     settings.linux.altitude = 850;
+    settings.linux.binaryEnabled = false;
+
+    settings.kiss.monitor = false;
+    settings.kiss.signalReport = false;
+
+    settings.loraScheduler.enabled = false;
+    settings.loraScheduler.aprsSlot = 600000; // 10 minutes
+
+    for (auto &profile : settings.loraScheduler.profiles) {
+        profile.frequency = settings.lora.frequency;
+        profile.bandwidth = 125;
+        profile.codingRate = 5;
+        profile.outputPower = settings.lora.outputPower;
+        profile.slot = 0;
+    }
+
+    strcpy_P(settings.loraScheduler.profiles[0].name, PSTR("fast"));
+    settings.loraScheduler.profiles[0].spreadingFactor = 9;
+    strcpy_P(settings.loraScheduler.profiles[1].name, PSTR("local"));
+    settings.loraScheduler.profiles[1].spreadingFactor = 7;
 
     settings.rtc.enabled = true;
     settings.rtc.wakeUpPin = 6;
@@ -409,91 +534,37 @@ DateTime System::getDateTime() const {
 }
 
 void System::printSettings() {
-    Log.traceln(F("[CONFIG] lora.frequency = %F"), settings.lora.frequency);
-    Log.traceln(F("[CONFIG] lora.bandwidth = %u"), settings.lora.bandwidth);
-    Log.traceln(F("[CONFIG] lora.spreadingFactor = %u"), settings.lora.spreadingFactor);
-    Log.traceln(F("[CONFIG] lora.codingRate = %u"), settings.lora.codingRate);
-    Log.traceln(F("[CONFIG] lora.outputPower = %u"), settings.lora.outputPower);
-    Log.traceln(F("[CONFIG] lora.txEnabled = %T"), settings.lora.txEnabled);
-    Log.traceln(F("[CONFIG] lora.watchdogTxEnabled = %T"), settings.lora.watchdogTxEnabled);
-    Log.traceln(F("[CONFIG] lora.intervalTimeoutWatchdogTx = %u"), settings.lora.intervalTimeoutWatchdogTx);
-
-    Log.traceln(F("[CONFIG] aprs.call = %s"), settings.aprs.call);
-    Log.traceln(F("[CONFIG] aprs.destination = %s"), settings.aprs.destination);
-    Log.traceln(F("[CONFIG] aprs.path = %s"), settings.aprs.path);
-    Log.traceln(F("[CONFIG] aprs.comment = %s"), settings.aprs.comment);
-    Log.traceln(F("[CONFIG] aprs.status = %s"), settings.aprs.status);
-    Log.traceln(F("[CONFIG] aprs.symbol = %c"), settings.aprs.symbol);
-    Log.traceln(F("[CONFIG] aprs.symbolTable = %c"), settings.aprs.symbolTable);
-    Log.traceln(F("[CONFIG] aprs.latitude = %D"), settings.aprs.latitude);
-    Log.traceln(F("[CONFIG] aprs.longitude = %D"), settings.aprs.longitude);
-    Log.traceln(F("[CONFIG] aprs.altitude = %u"), settings.aprs.altitude);
-    Log.traceln(F("[CONFIG] aprs.digipeaterEnabled = %T"), settings.aprs.digipeaterEnabled);
-    Log.traceln(F("[CONFIG] aprs.telemetryEnabled = %T"), settings.aprs.telemetryEnabled);
-    Log.traceln(F("[CONFIG] aprs.intervalTelemetry = %u"), settings.aprs.intervalTelemetry);
-    Log.traceln(F("[CONFIG] aprs.statusEnabled = %T"), settings.aprs.statusEnabled);
-    Log.traceln(F("[CONFIG] aprs.intervalStatus = %u"), settings.aprs.intervalStatus);
-    Log.traceln(F("[CONFIG] aprs.positionWeatherEnabled = %T"), settings.aprs.positionWeatherEnabled);
-    Log.traceln(F("[CONFIG] aprs.intervalPositionWeather = %u"), settings.aprs.intervalPositionWeather);
-    Log.traceln(F("[CONFIG] aprs.telemetryInPosition = %d"), settings.aprs.telemetryInPosition);
-    Log.traceln(F("[CONFIG] aprs.telemetrySequenceNumber = %d"), settings.aprs.telemetrySequenceNumber);
-
-    Log.traceln(F("[CONFIG] meshtastic.watchdogEnabled = %T"), settings.meshtastic.watchdogEnabled);
-    Log.traceln(F("[CONFIG] meshtastic.intervalTimeoutWatchdog = %u"), settings.meshtastic.intervalTimeoutWatchdog);
-    Log.traceln(F("[CONFIG] meshtastic.pin = %u"), settings.meshtastic.pin);
-    Log.traceln(F("[CONFIG] meshtastic.i2cSlaveEnabled = %T"), settings.meshtastic.i2cSlaveEnabled);
-    Log.traceln(F("[CONFIG] meshtastic.i2cSlaveAddress = %X"), settings.meshtastic.i2cSlaveAddress);
-    Log.traceln(F("[CONFIG] meshtastic.aprsSendItemEnabled = %T"), settings.meshtastic.aprsSendItemEnabled);
-    Log.traceln(F("[CONFIG] meshtastic.intervalSendItem = %u"), settings.meshtastic.intervalSendItem);
-    Log.traceln(F("[CONFIG] meshtastic.itemName = %s"), settings.meshtastic.itemName);
-    Log.traceln(F("[CONFIG] meshtastic.itemComment = %s"), settings.meshtastic.itemComment);
-    Log.traceln(F("[CONFIG] meshtastic.symbol = %c"), settings.meshtastic.symbol);
-    Log.traceln(F("[CONFIG] meshtastic.symbolTable = %c"), settings.meshtastic.symbolTable);
-
-    Log.traceln(F("[CONFIG] mpptWatchdog.enabled = %T"), settings.mpptWatchdog.enabled);
-    Log.traceln(F("[CONFIG] mpptWatchdog.timeout = %u"), settings.mpptWatchdog.timeout);
-    Log.traceln(F("[CONFIG] mpptWatchdog.intervalFeed = %u"), settings.mpptWatchdog.intervalFeed);
-    Log.traceln(F("[CONFIG] mpptWatchdog.timeOff = %u"), settings.mpptWatchdog.timeOff);
-
-    Log.traceln(F("[CONFIG] boxOpened.enabled = %T"), settings.boxOpened.enabled);
-    Log.traceln(F("[CONFIG] boxOpened.intervalCheck = %u"), settings.boxOpened.intervalCheck);
-    Log.traceln(F("[CONFIG] boxOpened.pin = %u"), settings.boxOpened.pin);
-
-    Log.traceln(F("[CONFIG] weather.enabled = %T"), settings.weather.enabled);
-    Log.traceln(F("[CONFIG] weather.intervalCheck = %u"), settings.weather.intervalCheck);
-
-    Log.traceln(F("[CONFIG] energy.intervalCheck = %u"), settings.energy.intervalCheck);
-    Log.traceln(F("[CONFIG] energy.type = %d"), settings.energy.type);
-    Log.traceln(F("[CONFIG] energy.adcPin = %u"), settings.energy.adcPin);
-    Log.traceln(F("[CONFIG] energy.inaChannelBattery = %u"), settings.energy.inaChannelBattery);
-    Log.traceln(F("[CONFIG] energy.inaChannelSolar = %u"), settings.energy.inaChannelSolar);
-    Log.traceln(F("[CONFIG] energy.mpptPowerOnVoltage = %u"), settings.energy.mpptPowerOnVoltage);
-    Log.traceln(F("[CONFIG] energy.mpptPowerOffVoltage = %u"), settings.energy.mpptPowerOffVoltage);
-
-    Log.traceln(F("[CONFIG] linux.watchdogEnabled = %T"), settings.linux.watchdogEnabled);
-    Log.traceln(F("[CONFIG] linux.intervalTimeoutWatchdog = %u"), settings.linux.intervalTimeoutWatchdog);
-    Log.traceln(F("[CONFIG] linux.pin = %u"), settings.linux.pin);
-    Log.traceln(F("[CONFIG] linux.nprPin = %u"), settings.linux.nprPin);
-    Log.traceln(F("[CONFIG] linux.wifiPin = %u"), settings.linux.wifiPin);
-    Log.traceln(F("[CONFIG] linux.aprsSendItemEnabled = %T"), settings.linux.aprsSendItemEnabled);
-    Log.traceln(F("[CONFIG] linux.intervalSendItem = %lu"), settings.linux.intervalSendItem);
-    Log.traceln(F("[CONFIG] linux.itemName = %s"), settings.linux.itemName);
-    Log.traceln(F("[CONFIG] linux.itemComment = %s"), settings.linux.itemComment);
-    Log.traceln(F("[CONFIG] linux.symbol = %c"), settings.linux.symbol);
-    Log.traceln(F("[CONFIG] linux.symbolTable = %c"), settings.linux.symbolTable);
-
-    Log.traceln(F("[CONFIG] rtc.enabled = %T"), settings.rtc.enabled);
-    Log.traceln(F("[CONFIG] rtc.wakeUpPin = %u"), settings.rtc.wakeUpPin);
-
-    Log.traceln(F("[CONFIG] useInternalWatchdog = %T"), settings.useInternalWatchdog);
-
-    uint8_t frameIndex = 0;
-    for (auto &[callsign, time, rssi, snr, content, count, digipeaterCallsign, digipeaterCount, reserved] : settings.aprsCallsignsHeard) {
-        if (strlen(callsign) > 0 && strlen(content)) {
-            getDateTimeStringFromEpoch(time, bufferText, BUFFER_LENGTH);
-            Log.traceln(F("[CONFIG] APRS Frame received #%d at %s from %s with SNR %F and RSSI %F, content: %s. Digi (%d) and last via %s. Count total %u"), frameIndex++, bufferText, callsign, snr, rssi, content, digipeaterCount, digipeaterCallsign, count);
+    SettingsRegistry::print(&settings);
+}
+
+void System::printSettingsJson(const bool onUsb) {
+    SettingsRegistry::writeJson(onUsb ? &serialJsonWriter : &serialLinuxJsonWriter, &settings);
+
+    if (onUsb) {
+        Serial.println();
+    }
+}
+
+void System::printStats() {
+    Log.infoln(F("[STATS] Loop runs %u, average %uus, p99 %uus, max %uus, period from %uus to %uus"), loopStats.getCount(), loopStats.getAverage(), loopStats.percentile(99), loopStats.getMax(), loopPeriodStats.getMin(), loopPeriodStats.getMax());
+
+    for (int i = 0; i < MAX_THREADS; i++) {
+        if (const auto thread = static_cast<MyThread *>(threadController.get(i)); thread != nullptr) { // NOLINT(*-pro-type-static-cast-downcast)
+            Log.infoln(F("[STATS] %s runs %u, min %uus, average %uus, p99 %uus, max %uus, overruns %u"), thread->ThreadName.c_str(), thread->stats.getCount(), thread->stats.getMin(), thread->stats.getAverage(), thread->stats.percentile(99), thread->stats.getMax(), thread->stats.getOverruns());
+        }
+    }
+}
+
+MyThread *System::getSlowestThread() {
+    MyThread *slowest = nullptr;
+
+    for (int i = 0; i < MAX_THREADS; i++) {
+        if (const auto thread = static_cast<MyThread *>(threadController.get(i)); thread != nullptr && (slowest == nullptr || thread->stats.getMax() > slowest->stats.getMax())) { // NOLINT(*-pro-type-static-cast-downcast)
+            slowest = thread;
         }
     }
+
+    return slowest;
 }
 
 void System::planReboot() {
@@ -506,129 +577,287 @@ void System::planDfu() {
     timerDfu.restart();
 }
 
-void System::printJson(const bool onUsb) {
+void System::printJson(const bool onUsb, const uint32_t sections, const uint32_t since) {
     int16_t temperatureBattery = 0;
 
-    if (settings.energy.type == mpptchg && !mpptChgCharger.getIndexedValue(VAL_INT_TEMP, &temperatureBattery)) {
+    if (sections & JsonBox && settings.energy.type == mpptchg && !mpptChgCharger.getIndexedValue(VAL_INT_TEMP, &temperatureBattery)) {
         Log.warningln(F("[SYSTEM] Impossible to get MPPT Temperature"));
     }
 
-    const bool isBoxOpened = ldrBoxOpenedThread->isBoxOpened(); // Here to avoid log serial
+    const bool isBoxOpened = sections & JsonBox && ldrBoxOpenedThread->isBoxOpened(); // Here to avoid log serial
     JsonWriter *jsonWriter = onUsb ? &serialJsonWriter : &serialLinuxJsonWriter;
 
     auto json = &jsonWriter->beginObject()
             .property(F("uptime"), millis() / 1000)
-            .property(F("time"), getDateTime().unixtime())
-            .beginObject(F("errors"))
+            .property(F("time"), getDateTime().unixtime());
+
+    if (sections & JsonErrors) {
+        json = &json->beginObject(F("errors"))
                 .property(F("lora"), communication.hasError())
                 .property(F("energy"), energyThread->hasError())
                 .property(F("weather"), weatherThread->hasError())
-            .endObject()
-            .beginObject(F("energy"))
+            .endObject();
+    }
+
+    if (sections & JsonAirtime) {
+        json = &json->beginObject(F("airtime"))
+                .property(F("lastHour"), communication.airtime.lastHour())
+                .property(F("total"), static_cast<uint32_t>(communication.airtime.getTotal() / 1000))
+                .property(F("dutyCycle"), static_cast<uint32_t>(communication.airtime.dutyCyclePerMille()))
+                .property(F("dutyCycleLimit"), static_cast<uint32_t>(settings.lora.dutyCycle))
+                .property(F("deferred"), communication.airtime.deferred)
+                .property(F("dropped"), communication.airtime.dropped)
+                .property(F("profile"), LoRaScheduler::getName(communication.scheduler.getProfile(), settings.loraScheduler))
+                .property(F("profileHeld"), communication.scheduler.getHeld() != LORA_PROFILE_AUTO)
+                .beginArray(F("profiles"));
+
+        for (uint8_t i = 0; i < LORA_PROFILES; i++) {
+            const LoRaProfileStats &stats = communication.scheduler.stats[i];
+
+            json = &json->beginObject()
+                    .property(F("name"), LoRaScheduler::getName(i, settings.loraScheduler))
+                    .property(F("time"), static_cast<uint32_t>(communication.scheduler.getTime(i) / 1000))
+                    .property(F("received"), stats.received)
+                    .property(F("sent"), stats.sent)
+                    .property(F("airtime"), static_cast<uint32_t>(stats.airtime / 1000))
+                .endObject();
+        }
+
+        json = &json->endArray().endObject();
+    }
+
+    if (sections & JsonTxQueue) {
+        json = &json->beginObject(F("txQueue"))
+                .property(F("depth"), static_cast<uint32_t>(communication.txQueue.depth()))
+                .property(F("maxDepth"), static_cast<uint32_t>(communication.txQueue.stats.maxDepth))
+                .property(F("sent"), communication.txQueue.stats.sent)
+                .property(F("waitAverage"), communication.txQueue.waitAverage())
+                .property(F("waitMax"), communication.txQueue.stats.waitMax)
+                .beginObject(F("dropped"))
+                    .property(F("ack"), communication.txQueue.stats.dropped[TxPriorityAck])
+                    .property(F("digipeat"), communication.txQueue.stats.dropped[TxPriorityDigipeat])
+                    .property(F("kiss"), communication.txQueue.stats.dropped[TxPriorityKiss])
+                    .property(F("beacon"), communication.txQueue.stats.dropped[TxPriorityBeacon])
+                .endObject()
+            .endObject();
+    }
+
+    if (sections & JsonDupeCache) {
+        json = &json->beginObject(F("dupeCache"))
+                .property(F("checked"), communication.dupeCache.checked)
+                .property(F("hits"), communication.dupeCache.hits)
+            .endObject();
+    }
+
+    if (sections & JsonEnergyBudget) {
+        json = &json->beginObject(F("energyBudget"))
+                .property(F("idle"), energyBudget.lastDay(EnergyIdle))
+                .property(F("sleep"), energyBudget.lastDay(EnergySleep))
+                .property(F("tx"), energyBudget.lastDay(EnergyTx))
+                .property(F("linux"), energyBudget.lastDay(EnergyLinux))
+                .property(F("meshtastic"), energyBudget.lastDay(EnergyMeshtastic))
+                .property(F("consumed"), energyBudget.lastDayConsumed())
+                .property(F("harvested"), energyBudget.lastDayHarvested())
+                .property(F("txPerFrame"), energyBudget.perFrame())
+                .beginObject(F("power"))
+                    .property(F("idle"), energyBudget.getPower(EnergyIdle))
+                    .property(F("linux"), energyBudget.getPower(EnergyLinux))
+                    .property(F("meshtastic"), energyBudget.getPower(EnergyMeshtastic))
+                .endObject()
+            .endObject();
+    }
+
+    if (sections & JsonLoadShedding) {
+        json = &json->beginObject(F("loadShedding"))
+                .property(F("enabled"), settings.energy.loadShedding)
+                .property(F("tier"), loadSheddingThread->getTier())
+                .property(F("digipeatOnlyDirect"), communication.digipeatOnlyDirect.load(std::memory_order_relaxed))
+            .endObject();
+    }
+
+    if (sections & JsonSleep) {
+        json = &json->beginObject(F("sleep"))
+                .property(F("light"), settings.energy.lightSleep)
+                .property(F("rtcWakeUps"), rtcWakeUps)
+            .endObject();
+    }
+
+    if (sections & JsonRadioCore) {
+        json = &json->beginObject(F("radioCore"))
+                .property(F("loops"), getRadioCoreLoops())
+                .property(F("txRequestsFull"), communication.txRequests.full)
+                .property(F("rxFramesFull"), communication.rxFrames.full)
+                .beginObject(F("kiss"))
+                    .property(F("frames"), kiss.stats.frames)
+                    .property(F("commands"), kiss.stats.commands)
+                    .property(F("dropped"), kiss.stats.dropped)
+                    .property(F("overflows"), kiss.stats.overflows)
+                    .property(F("sent"), kiss.stats.sent)
+                    .property(F("sentDropped"), kiss.stats.sentDropped)
+                .endObject()
+            .endObject();
+    }
+
+    if (sections & JsonAprsHeardLog) {
+        json = &json->beginObject(F("aprsHeardLog"))
+                .property(F("records"), static_cast<uint32_t>(aprsHeard.getRecordsInLog()))
+                .property(F("appended"), aprsHeard.stats.appended)
+                .property(F("flushes"), aprsHeard.stats.flushes)
+                .property(F("compactions"), aprsHeard.stats.compactions)
+                .property(F("stations"), static_cast<uint32_t>(aprsHeard.size()))
+                .property(F("evicted"), aprsHeard.stats.evicted)
+            .endObject();
+    }
+
+    if (sections & JsonEnergy) {
+        json = &json->beginObject(F("energy"))
                 .property(F("nextRun"), static_cast<uint32_t>(energyThread->timeBeforeRun()) / 1000)
                 .property(F("voltageBattery"), energyThread->hasError() ? 0 : energyThread->getVoltageBattery())
                 .property(F("currentBattery"), energyThread->hasError() ? 0 : energyThread->getCurrentBattery())
                 .property(F("voltageSolar"), energyThread->hasError() ? 0 : energyThread->getVoltageSolar())
                 .property(F("currentSolar"), energyThread->hasError() ? 0 : energyThread->getCurrentBattery())
-            .endObject()
-            .beginObject(F("box"));
-
-    if (settings.rtc.enabled) {
-        json = &json->property(F("temperatureRtc"), settings.rtc.enabled ? rtc.getTemperature() : 0);
+            .endObject();
     }
 
-    if (settings.energy.type == mpptchg) {
-        json = &json->property(F("temperatureBattery"), !energyThread->hasError() ? temperatureBattery / 10.0 : 0);
-    }
+    if (sections & JsonBox) {
+        json = &json->beginObject(F("box"));
 
-    if (ldrBoxOpenedThread->enabled) {
-        json = &json->property(F("opened"), isBoxOpened);
+        if (settings.rtc.enabled) {
+            json = &json->property(F("temperatureRtc"), settings.rtc.enabled ? rtc.getTemperature() : 0);
+        }
+
+        if (settings.energy.type == mpptchg) {
+            json = &json->property(F("temperatureBattery"), !energyThread->hasError() ? temperatureBattery / 10.0 : 0);
+        }
+
+        if (ldrBoxOpenedThread->enabled) {
+            json = &json->property(F("opened"), isBoxOpened);
+        }
+
+        json = &json->endObject();
     }
 
-    json = &json->endObject()
-            .beginObject(F("weather"))
+    if (sections & JsonWeather) {
+        json = &json->beginObject(F("weather"))
                 .property(F("nextRun"), static_cast<uint32_t>(weatherThread->timeBeforeRun()) / 1000)
                 .property(F("temperature"), weatherThread->enabled && !weatherThread->hasError() ? weatherThread->getTemperature() : 0)
                 .property(F("humidity"), weatherThread->enabled && !weatherThread->hasError() ? weatherThread->getHumidity() : 0)
                 .property(F("pressure"), weatherThread->enabled && !weatherThread->hasError() ? weatherThread->getPressure() : 0)
-            .endObject()
-            .beginObject(F("aprsSender"))
+            .endObject();
+    }
+
+    if (sections & JsonAprsSender) {
+        json = &json->beginObject(F("aprsSender"))
                 .property(F("sendPositionNextRun"), static_cast<uint32_t>(sendPositionThread->timeBeforeRun()) / 1000)
                 .property(F("sendTelemetriesNextRun"), static_cast<uint32_t>(sendTelemetriesThread->timeBeforeRun()) / 1000)
                 .property(F("sendStatusNextRun"), static_cast<uint32_t>(sendStatusThread->timeBeforeRun()) / 1000);
 
-    if (sendMeshtasticAprsThread->enabled) {
-        json = &json->property(F("sendMeshtasticNextRun"), static_cast<uint32_t>(sendMeshtasticAprsThread->timeBeforeRun()) / 1000);
-    }
-    if (sendLinuxAprsThread->enabled) {
-        json = &json->property(F("sendMeshtasticNextRun"), static_cast<uint32_t>(sendLinuxAprsThread->timeBeforeRun()) / 1000);
+        if (sendMeshtasticAprsThread->enabled) {
+            json = &json->property(F("sendMeshtasticNextRun"), static_cast<uint32_t>(sendMeshtasticAprsThread->timeBeforeRun()) / 1000);
+        }
+        if (sendLinuxAprsThread->enabled) {
+            json = &json->property(F("sendMeshtasticNextRun"), static_cast<uint32_t>(sendLinuxAprsThread->timeBeforeRun()) / 1000);
+        }
+
+        json = &json->endObject();
     }
 
-    json = &json->endObject()
-            .beginObject(F("watchdog"));
+    if (sections & JsonWatchdog) {
+        json = &json->beginObject(F("watchdog"));
 
-    if (settings.energy.type == mpptchg && watchdogSlaveMpptChgThread->enabled) {
-        json = &json->beginObject(F("mppt"))
-                .property(F("nextRun"), static_cast<uint32_t>(watchdogSlaveMpptChgThread->timeBeforeRun()) / 1000)
-                .property(F("lastFed"), static_cast<uint32_t>(watchdogSlaveMpptChgThread->timeSinceFed()) / 1000)
-            .endObject();
-    }
+        if (settings.energy.type == mpptchg && watchdogSlaveMpptChgThread->enabled) {
+            json = &json->beginObject(F("mppt"))
+                    .property(F("nextRun"), static_cast<uint32_t>(watchdogSlaveMpptChgThread->timeBeforeRun()) / 1000)
+                    .property(F("lastFed"), static_cast<uint32_t>(watchdogSlaveMpptChgThread->timeSinceFed()) / 1000)
+                .endObject();
+        }
 
-    if (watchdogSlaveLoraTxThread->enabled) {
-        json = &json->beginObject(F("loraTx"))
-                .property(F("nextRun"), static_cast<uint32_t>(watchdogSlaveLoraTxThread->timeBeforeRun()) / 1000)
-                .property(F("lastFed"), static_cast<uint32_t>(watchdogSlaveLoraTxThread->timeSinceFed()) / 1000)
-            .endObject();
-    }
+        if (watchdogSlaveLoraTxThread->enabled) {
+            json = &json->beginObject(F("loraTx"))
+                    .property(F("nextRun"), static_cast<uint32_t>(watchdogSlaveLoraTxThread->timeBeforeRun()) / 1000)
+                    .property(F("lastFed"), static_cast<uint32_t>(watchdogSlaveLoraTxThread->timeSinceFed()) / 1000)
+                .endObject();
+        }
 
-    if (watchdogMeshtastic->enabled) {
-        json = &json->beginObject(F("meshtastic"))
-                .property(F("nextRun"), static_cast<uint32_t>(watchdogMeshtastic->timeBeforeRun()) / 1000)
-                .property(F("lastFed"), static_cast<uint32_t>(watchdogMeshtastic->timeSinceFed()) / 1000)
-            .endObject();
-    }
+        if (watchdogMeshtastic->enabled) {
+            json = &json->beginObject(F("meshtastic"))
+                    .property(F("nextRun"), static_cast<uint32_t>(watchdogMeshtastic->timeBeforeRun()) / 1000)
+                    .property(F("lastFed"), static_cast<uint32_t>(watchdogMeshtastic->timeSinceFed()) / 1000)
+                .endObject();
+        }
 
-    if (watchdogLinux->enabled) {
-        json = &json->beginObject(F("linux"))
-                .property(F("nextRun"), static_cast<uint32_t>(watchdogLinux->timeBeforeRun()) / 1000)
-                .property(F("lastFed"), static_cast<uint32_t>(watchdogLinux->timeSinceFed()) / 1000)
-            .endObject();
+        if (watchdogLinux->enabled) {
+            json = &json->beginObject(F("linux"))
+                    .property(F("nextRun"), static_cast<uint32_t>(watchdogLinux->timeBeforeRun()) / 1000)
+                    .property(F("lastFed"), static_cast<uint32_t>(watchdogLinux->timeSinceFed()) / 1000)
+                .endObject();
+        }
+
+        json = &json->endObject();
+    }
+
+    if (sections & JsonRuntime) {
+        json = &json->beginObject(F("runtime"))
+                .beginObject(F("loop"))
+                    .property(F("runs"), loopStats.getCount())
+                    .property(F("average"), loopStats.getAverage())
+                    .property(F("p99"), loopStats.percentile(99))
+                    .property(F("max"), loopStats.getMax())
+                    .property(F("periodMin"), loopPeriodStats.getMin())
+                    .property(F("periodMax"), loopPeriodStats.getMax())
+                    .property(F("jitter"), loopPeriodStats.getMax() - loopPeriodStats.getMin())
+                .endObject()
+                .beginArray(F("threads"));
+
+        for (int i = 0; i < MAX_THREADS; i++) {
+            if (const auto thread = static_cast<MyThread *>(threadController.get(i)); thread != nullptr) { // NOLINT(*-pro-type-static-cast-downcast)
+                json = &json->beginObject()
+                    .property(F("name"), thread->ThreadName.c_str())
+                    .property(F("runs"), thread->stats.getCount())
+                    .property(F("min"), thread->stats.getMin())
+                    .property(F("average"), thread->stats.getAverage())
+                    .property(F("p99"), thread->stats.percentile(99))
+                    .property(F("max"), thread->stats.getMax())
+                    .property(F("overruns"), thread->stats.getOverruns())
+                .endObject();
+            }
+        }
+
+        json = &json->endArray().endObject();
     }
 
-    json = &json->endObject().beginArray(F("aprsReceived"));
+    if (sections & JsonAprsReceived) {
+        json = &json->beginArray(F("aprsReceived"));
 
-    for (auto &[callsign, time, rssi, snr, content, count, digipeaterCallsign, digipeaterCount, reserved] : settings.aprsCallsignsHeard) {
-        if (strlen(callsign) > 0 && strlen(content)) {
+        // Most recent first, so the delta stops at the first one heard before
+        for (auto station = aprsHeard.first(); station != nullptr && station->time >= since; station = aprsHeard.next(station)) {
             json = &json->beginObject()
-            .property(F("callsign"), callsign)
-                .property(F("time"), static_cast<uint32_t>(time))
-                .property(F("packet"), content)
-                .property(F("snr"), snr)
-                .property(F("rssi"), rssi)
-                .property(F("count"), static_cast<uint32_t>(count))
-                .property(F("digipeaterCount"), digipeaterCount)
-                .property(F("digipeaterCallsign"), digipeaterCallsign)
+            .property(F("callsign"), station->callsign)
+                .property(F("time"), station->time);
+
+            // Without packet once it left the ring of the last ones
+            if (const char *packet = aprsHeard.getPacket(station); strlen(packet) > 0) {
+                json = &json->property(F("packet"), packet);
+            }
+
+            json = &json->property(F("snr"), station->snr)
+                .property(F("rssi"), station->rssi)
+                .property(F("count"), station->count)
+                .property(F("digipeaterCount"), station->digipeaterCount)
+                .property(F("digipeaterCallsign"), station->digipeaterCallsign)
             .endObject();
         }
+
+        json = &json->endArray();
     }
 
-    json->endArray().endObject();
+    json->endObject();
 
     if (onUsb) {
         Serial.println();
     }
 }
 
-void System::sendToKissInterface(const uint8_t* data, size_t size) {
-    kissPacket = kiss_new_packet(buffer, BUFFER_LENGTH / 2);
-
-    kissPacket.data_length = size;
-    size = kiss_encode_packet(kissPacket, buffer, BUFFER_LENGTH * 2);
-
-    Serial2.write(buffer, size);
-    Serial2.flush();
-}
-
 void System::setClock(const bool slow) {
     isSlowClock = slow;
 
@@ -661,7 +890,6 @@ void System::setClock(const bool slow) {
     }
 
     Serial1.begin(115200);
-    Serial2.begin(115200);
 }
 
 GpioPin *System::getGpio(const uint8_t pin) {
@@ -1,5 +1,5 @@
 #include "Threads/Energy/EnergyAdcThread.h"
-#include "ArduinoLog.h"
+#include "Logging.h"
 #include "System.h"
 
 EnergyAdcThread::EnergyAdcThread(System *system, uint16_t *ocv, const size_t numOcvPoints, const uint8_t numCells) : EnergyThread(system, PSTR("ENERGY_ADC"), ocv, numOcvPoints, numCells),
@@ -11,7 +11,7 @@ bool EnergyAdcThread::fetchVoltageBattery() {
 
     for (uint32_t i = 0; i < ENERGY_ADC_BATTERY_SENSE_SAMPLES; i++) {
         const uint16_t value = adc->getValue();
-        Log.verboseln(F("[ENERGY_ADC] Sample %d : %d"), i, value);
+        LOG_VERBOSE(F("[ENERGY_ADC] Sample %d : %d"), i, value);
         raw += value;
     }
 
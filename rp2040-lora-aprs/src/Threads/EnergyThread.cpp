@@ -1,4 +1,4 @@
-#include "ArduinoLog.h"
+#include "Logging.h"
 #include "System.h"
 #include "Threads/EnergyThread.h"
 
@@ -40,7 +40,7 @@ uint8_t EnergyThread::getBatteryPercentage() const {
 }
 
 bool EnergyThread::runOnce() {
-    Log.traceln(F("[ENERGY] Fetch charger data"));
+    LOG_TRACE(F("[ENERGY] Fetch charger data"));
 
     if (!fetchVoltageBattery()) {
         Log.errorln(F("[MPPT] Fetch charger data VB error"));
@@ -64,5 +64,15 @@ bool EnergyThread::runOnce() {
 
     Log.infoln(F("[ENERGY] Vb: %dmV Ib: %dmA Vs: %dmV Is: %dmA Ic: %dmA Night: %T"), vb, ib, vs, is, getCurrentCharge(), isNight());
 
+    system->energyBudget.add({
+        static_cast<uint32_t>(millis()),
+        system->communication.airtime.getTotal(),
+        system->communication.txQueue.stats.sent,
+        system->getTimeWaiting(),
+        system->watchdogLinux->isGpioOn(),
+        system->watchdogMeshtastic->isGpioOn(),
+        vb, ib, vs, is
+    });
+
     return true;
 }
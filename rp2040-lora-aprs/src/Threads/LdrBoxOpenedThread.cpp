@@ -1,6 +1,6 @@
 #include "Threads/LdrBoxOpenedThread.h"
 #include "System.h"
-#include "ArduinoLog.h"
+#include "Logging.h"
 
 LdrBoxOpenedThread::LdrBoxOpenedThread(System *system) : MyThread(system, system->settings.boxOpened.intervalCheck, PSTR("LDR_BOX_OPENED")), ldr(new GpioPin(system->settings.boxOpened.pin, INPUT)) {
     enabled = system->settings.boxOpened.enabled;
@@ -21,6 +21,6 @@ bool LdrBoxOpenedThread::runOnce() {
         return system->communication.sendMessage(PSTR("F4HVV-7"), PSTR("Boîte ouverte !"));
     }
 
-    Log.traceln(F("[LDR_BOX_OPENED] Box closed"));
+    LOG_TRACE(F("[LDR_BOX_OPENED] Box closed"));
     return true;
 }
\ No newline at end of file
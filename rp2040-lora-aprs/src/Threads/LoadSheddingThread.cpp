@@ -0,0 +1,85 @@
+#include "Threads/LoadSheddingThread.h"
+#include "Logging.h"
+#include "System.h"
+
+LoadSheddingThread::LoadSheddingThread(System *system) : MyThread(system, system->settings.energy.intervalCheck, PSTR("LOAD_SHEDDING")) {
+}
+
+bool LoadSheddingThread::runOnce() {
+    const EnergyThread *energy = system->energyThread;
+
+    if (!system->settings.energy.loadShedding || !energy->hasBatteryPercentage()) {
+        setTier(0);
+        return true;
+    }
+
+    if (energy->hasError()) {
+        LOG_TRACE(F("[LOAD_SHEDDING] No battery measure, tier %d kept"), tier);
+        return true;
+    }
+
+    setTier(targetTier(energy->getBatteryPercentage()));
+
+    return true;
+}
+
+uint8_t LoadSheddingThread::targetTier(const uint8_t percentage) const {
+    const SettingsEnergy &settings = system->settings.energy;
+    uint8_t target = tier;
+
+    while (target < LOAD_SHEDDING_TIERS && percentage < settings.shedThresholds[target]) {
+        target++;
+    }
+
+    while (target > 0 && percentage >= settings.shedThresholds[target - 1] + settings.shedHysteresis) {
+        target--;
+    }
+
+    return target;
+}
+
+void LoadSheddingThread::setTier(const uint8_t newTier) {
+    if (newTier == tier) {
+        return;
+    }
+
+    Log.noticeln(F("[LOAD_SHEDDING] Tier %d to %d with battery at %d%%"), tier, newTier, system->energyThread->getBatteryPercentage());
+
+    const bool wasPowerOff = tier >= LOAD_SHEDDING_TIER_POWER_OFF;
+    tier = newTier;
+
+    applyIntervals();
+
+    if (const bool isPowerOff = tier >= LOAD_SHEDDING_TIER_POWER_OFF; isPowerOff != wasPowerOff) {
+        setPowerOff(isPowerOff);
+    }
+
+    system->communication.digipeatOnlyDirect.store(tier >= LOAD_SHEDDING_TIER_DIGIPEAT_DIRECT, std::memory_order_relaxed);
+}
+
+void LoadSheddingThread::applyIntervals() const {
+    const SettingsAprs &aprs = system->settings.aprs;
+
+    system->sendPositionThread->setInterval(aprs.intervalPositionWeather << tier);
+    system->sendStatusThread->setInterval(aprs.intervalStatus << tier);
+    system->sendTelemetriesThread->setInterval(aprs.intervalTelemetry << tier);
+    system->sendMeshtasticAprsThread->setInterval(system->settings.meshtastic.intervalSendItem << tier);
+    system->sendLinuxAprsThread->setInterval(system->settings.linux.intervalSendItem << tier);
+}
+
+void LoadSheddingThread::setPowerOff(const bool off) {
+    GpioPin *npr = system->getGpio(system->settings.linux.nprPin);
+    GpioPin *wifi = system->getGpio(system->settings.linux.wifiPin);
+
+    if (off) {
+        wasNprOn = npr->getState();
+        wasWifiOn = wifi->getState();
+        npr->setState(false);
+        wifi->setState(false);
+    } else {
+        npr->setState(wasNprOn);
+        wifi->setState(wasWifiOn);
+    }
+
+    system->watchdogLinux->setPoweredOff(off);
+}
@@ -1,6 +1,6 @@
 #include "Threads/Watchdog/WatchdogMasterPinThread.h"
 
-#include "ArduinoLog.h"
+#include "Logging.h"
 #include "System.h"
 #include "utils.h"
 
@@ -21,6 +21,10 @@ bool WatchdogMasterPinThread::init() {
 }
 
 bool WatchdogMasterPinThread::runOnce() {
+    if (poweredOff) {
+        return true;
+    }
+
     if (wantToSleep) { // User ask to sleep
         if (gpio->getState()) { // Currently running
             gpio->setState(LOW); // Shutdown
@@ -34,7 +38,7 @@ bool WatchdogMasterPinThread::runOnce() {
     }
 
     if (isFed()) {
-        Log.traceln(F("[%S] Dog fed"), ThreadName.c_str());
+        LOG_TRACE(F("[%S] Dog fed"), ThreadName.c_str());
         return true;
     }
 
@@ -44,6 +48,7 @@ bool WatchdogMasterPinThread::runOnce() {
     }
 
     Log.warningln(F("[%S] Dog not fed so toggle pin"), ThreadName.c_str());
+    system->binaryLink.watchdogFired(ThreadName.c_str());
 
     gpio->setState(LOW);
     delayWdt(TIME_WAIT_TOGGLE_WATCHDOG_MASTER);
@@ -62,4 +67,19 @@ void WatchdogMasterPinThread::sleep(const uint64_t millis) {
     Log.infoln(F("[%s] Sleep for %ums at next internal (%u)"), ThreadName.c_str(), millis, interval);
     timerSleep.setInterval(millis);
     wantToSleep = true;
+}
+
+void WatchdogMasterPinThread::setPoweredOff(const bool off) {
+    if (off == poweredOff) {
+        return;
+    }
+
+    Log.infoln(F("[%s] Powered %s"), ThreadName.c_str(), off ? "off" : "on");
+    poweredOff = off;
+    wantToSleep = false;
+    gpio->setState(!off);
+
+    if (!off) {
+        feed(); // Time to boot before being watched again
+    }
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 #include "Threads/Watchdog/WatchdogSlaveLoraTxThread.h"
 
-#include "ArduinoLog.h"
+#include "Logging.h"
 #include "System.h"
 
 WatchdogSlaveLoraTxThread::WatchdogSlaveLoraTxThread(System *system) : WatchdogThread(system, system->settings.lora.intervalTimeoutWatchdogTx, PSTR("WATCHDOG_LORA_TX")) {
@@ -9,7 +9,7 @@ WatchdogSlaveLoraTxThread::WatchdogSlaveLoraTxThread(System *system) : WatchdogT
 
 bool WatchdogSlaveLoraTxThread::runOnce() {
     if (isFed()) {
-        Log.traceln(F("[WATCHDOG_LORA_TX] Dog fed"));
+        LOG_TRACE(F("[WATCHDOG_LORA_TX] Dog fed"));
         return true;
     }
 
@@ -18,6 +18,7 @@ bool WatchdogSlaveLoraTxThread::runOnce() {
     }
 
     Log.errorln(F("[WATCHDOG_LORA_TX] No TX for a long time, reboot"));
+    system->binaryLink.watchdogFired(ThreadName.c_str());
     system->planReboot();
     return true;
 }
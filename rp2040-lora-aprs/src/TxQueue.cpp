@@ -0,0 +1,96 @@
+#include "TxQueue.h"
+#include "ArduinoLog.h"
+
+TxQueueFrame *TxQueue::push(const TxPriority priority) {
+    TxQueueFrame *slot = nullptr;
+
+    for (auto &frame : frames) {
+        if (!frame.used) {
+            slot = &frame;
+            break;
+        }
+    }
+
+    if (slot == nullptr) {
+        // Full: evict the newest frame of the lowest priority class, if lower than the new one
+        for (auto &frame : frames) {
+            if (frame.inFlight || frame.priority <= priority) {
+                continue;
+            }
+
+            if (slot == nullptr || frame.priority > slot->priority || (frame.priority == slot->priority && frame.sequence > slot->sequence)) {
+                slot = &frame;
+            }
+        }
+
+        if (slot == nullptr) {
+            Log.warningln(F("[TX_QUEUE] Full, frame of priority %d dropped"), priority);
+            stats.dropped[priority]++;
+            return nullptr;
+        }
+
+        Log.warningln(F("[TX_QUEUE] Full, frame of priority %d evicted"), slot->priority);
+        stats.dropped[slot->priority]++;
+        count--;
+    }
+
+    slot->size = 0;
+    slot->priority = priority;
+    slot->sequence = sequence++;
+    slot->enqueuedAt = millis();
+    slot->used = true;
+    slot->inFlight = false;
+
+    count++;
+    stats.enqueued++;
+
+    if (count > stats.maxDepth) {
+        stats.maxDepth = count;
+    }
+
+    return slot;
+}
+
+TxQueueFrame *TxQueue::next(const bool kissOnly) {
+    TxQueueFrame *result = nullptr;
+
+    for (auto &frame : frames) {
+        if (!frame.used) {
+            continue;
+        }
+
+        if (frame.inFlight) {
+            return &frame;
+        }
+
+        if (kissOnly && frame.priority != TxPriorityKiss) {
+            continue;
+        }
+
+        if (result == nullptr || frame.priority < result->priority || (frame.priority == result->priority && frame.sequence < result->sequence)) {
+            result = &frame;
+        }
+    }
+
+    return result;
+}
+
+void TxQueue::pop(TxQueueFrame *frame, const bool sent) {
+    frame->used = false;
+    frame->inFlight = false;
+    count--;
+
+    if (!sent) {
+        stats.dropped[frame->priority]++;
+        return;
+    }
+
+    const uint32_t wait = millis() - frame->enqueuedAt;
+
+    stats.sent++;
+    stats.waitTotal += wait;
+
+    if (wait > stats.waitMax) {
+        stats.waitMax = wait;
+    }
+}
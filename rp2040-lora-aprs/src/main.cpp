@@ -2,7 +2,6 @@
 #include "System.h"
 
 char bufferText[BUFFER_LENGTH]{};
-uint8_t buffer[BUFFER_LENGTH]{};
 
 System systemControl;
 
@@ -14,6 +13,19 @@ void loop() {
     systemControl.loop();
 }
 
+// Second core: started with the first one, but the radio needs the settings and the threads
+void setup1() {
+    while (!systemControl.isStarted()) {
+        delay(1);
+    }
+
+    systemControl.beginRadio();
+}
+
+void loop1() {
+    systemControl.loopRadio();
+}
+
 void delayWdt(const uint32_t milliseconds) {
     if (systemControl.settings.useInternalWatchdog) {
         const uint64_t startTime = millis();
@@ -0,0 +1,136 @@
+// Fuzz and benchmark of the KISS frames of the MCU, on the host:
+// random frames up to TRX_BUFFER bytes and the worst cases, all FEND and all FESC, are encoded in an arena of
+// KISS_ENCODED_MAX bytes followed by canaries, then decoded back byte by byte. Fails on any overrun or difference,
+// then prints the encoding throughput.
+//
+// Usage: kiss-fuzz [frames] [seed], 200000 frames by default
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "KissFrame.h"
+
+#define CANARY_SIZE 64
+#define CANARY 0xA5
+
+static uint8_t arena[KISS_ENCODED_MAX + CANARY_SIZE];
+
+static bool checkCanary() {
+    for (size_t i = KISS_ENCODED_MAX; i < sizeof(arena); i++) {
+        if (arena[i] != CANARY) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool roundTrip(const uint8_t command, const uint8_t *data, const size_t size, size_t *encodedSize) {
+    const size_t length = KissFrame::encode(command, data, size, arena);
+
+    if (!checkCanary()) {
+        fprintf(stderr, "Overrun of the arena by a frame of %zu bytes\n", size);
+        return false;
+    }
+
+    if (length == 0 || length > KISS_ENCODED_MAX) {
+        fprintf(stderr, "Frame of %zu bytes encoded in %zu bytes\n", size, length);
+        return false;
+    }
+
+    KissFrameDecoder decoder;
+    size_t ended = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        if (decoder.push(arena[i])) {
+            ended++;
+
+            if (i != length - 1) {
+                fprintf(stderr, "Frame of %zu bytes ended at byte %zu of %zu\n", size, i, length);
+                return false;
+            }
+        }
+    }
+
+    if (ended != 1 || decoder.isOverflow() || decoder.getLength() != size + 1
+        || decoder.getFrame()[0] != command || memcmp(decoder.getFrame() + 1, data, size) != 0) {
+        fprintf(stderr, "Frame of %zu bytes not decoded back\n", size);
+        return false;
+    }
+
+    *encodedSize = length;
+    return true;
+}
+
+int main(const int argc, const char **argv) {
+    const unsigned long frames = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200000;
+    const unsigned long seed = argc > 2 ? strtoul(argv[2], nullptr, 10) : std::random_device()();
+
+    memset(arena, CANARY, sizeof(arena));
+
+    uint8_t data[TRX_BUFFER + 1];
+    size_t encodedSize;
+
+    // Worst cases, every byte escaped
+    for (const uint8_t byte : {KISS_FEND, KISS_FESC}) {
+        memset(data, byte, TRX_BUFFER);
+
+        if (!roundTrip(byte, data, TRX_BUFFER, &encodedSize)) {
+            return 1;
+        }
+    }
+
+    if (KissFrame::encode(0, data, TRX_BUFFER + 1, arena) != 0 || !checkCanary()) {
+        fprintf(stderr, "Frame longer than TRX_BUFFER encoded\n");
+        return 1;
+    }
+
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<size_t> sizes(0, TRX_BUFFER);
+    std::uniform_int_distribution<int> bytes(0, 255);
+    std::uniform_int_distribution<int> escapes(0, 3); // Also frames made mostly of FEND and FESC
+
+    unsigned long long bytesIn = 0;
+
+    for (unsigned long i = 0; i < frames; i++) {
+        const size_t size = sizes(random);
+        const bool escaped = escapes(random) == 0;
+
+        for (size_t j = 0; j < size; j++) {
+            data[j] = escaped && bytes(random) < 192 ? (bytes(random) & 1 ? KISS_FEND : KISS_FESC) : bytes(random);
+        }
+
+        if (!roundTrip(static_cast<uint8_t>(bytes(random) & 0x0F), data, size, &encodedSize)) {
+            fprintf(stderr, "Seed %lu, frame %lu\n", seed, i);
+            return 1;
+        }
+
+        bytesIn += size;
+    }
+
+    // Encoding alone, of a random frame of the longest size
+    for (size_t j = 0; j < TRX_BUFFER; j++) {
+        data[j] = bytes(random);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    size_t sink = 0;
+
+    for (unsigned long i = 0; i < frames; i++) {
+        sink += KissFrame::encode(0, data, TRX_BUFFER, arena);
+    }
+
+    const double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    if (!checkCanary()) {
+        fprintf(stderr, "Overrun of the arena during the benchmark\n");
+        return 1;
+    }
+
+    printf("%lu frames of %llu bytes round-tripped without overrun, seed %lu\n", frames, bytesIn, seed);
+    printf("Encoding: %.1f bytes/us (%zu bytes written)\n", static_cast<double>(frames) * TRX_BUFFER / elapsed, sink);
+
+    return 0;
+}
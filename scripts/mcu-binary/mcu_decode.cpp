@@ -0,0 +1,113 @@
+// Reads the binary frames of the MCU and prints one CSV line per message, first column is its type:
+// status,uptime,time,voltageBattery,currentBattery,voltageSolar,currentSolar,temperatureRtc,temperatureBattery,temperature,humidity,pressure,errors,loadSheddingTier,airtimeLastHour,dutyCycle,framesSent,framesDropped,consumedLastDay,harvestedLastDay,stations
+// station|heard,callsign,packet,snr,rssi,time,count,digipeaterCount,digipeaterCallsign
+// error,errors
+// watchdog,name
+//
+// Usage: mcu-decode [device], stdin if no device, the UART must already be set up with stty
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "BinaryFrame.h"
+
+static std::string quote(const char *text, size_t length) {
+    std::string quoted = "\"";
+
+    for (size_t i = 0; i < length && text[i] != '\0'; i++) {
+        if (text[i] == '"') {
+            quoted += '"';
+        }
+
+        quoted += text[i];
+    }
+
+    return quoted + "\"";
+}
+
+static void printStatus(const uint8_t *payload, uint16_t length) {
+    BinaryStatusPayload status{};
+
+    if (length < sizeof(status)) {
+        fprintf(stderr, "Status of %u bytes too short\n", length);
+        return;
+    }
+
+    memcpy(&status, payload, sizeof(status));
+
+    printf("status,%u,%u,%d,%d,%d,%d,%.2f,%.2f,%.2f,%.2f,%.2f,%u,%u,%u,%u,%u,%u,%u,%u,%u\n",
+           status.uptime, status.time,
+           status.voltageBattery, status.currentBattery, status.voltageSolar, status.currentSolar,
+           status.temperatureRtc / 100.0, status.temperatureBattery / 100.0,
+           status.temperature / 100.0, status.humidity / 100.0, status.pressure / 100.0,
+           status.errors, status.loadSheddingTier, status.airtimeLastHour, status.dutyCycle,
+           status.framesSent, status.framesDropped, status.consumedLastDay, status.harvestedLastDay, status.stations);
+}
+
+static void printStation(const char *type, const uint8_t *payload, uint16_t length) {
+    BinaryStationPayload station{};
+
+    if (length < sizeof(station)) {
+        fprintf(stderr, "Station of %u bytes too short\n", length);
+        return;
+    }
+
+    memcpy(&station, payload, sizeof(station));
+
+    const auto packet = reinterpret_cast<const char *>(payload + sizeof(station));
+
+    printf("%s,%s,%s,%.2f,%.2f,%u,%u,%u,%s\n", type,
+           quote(station.callsign, BINARY_CALLSIGN_LENGTH).c_str(),
+           quote(packet, length - sizeof(station)).c_str(),
+           station.snr / 100.0, station.rssi / 100.0, station.time, station.count, station.digipeaterCount,
+           quote(station.digipeaterCallsign, BINARY_CALLSIGN_LENGTH).c_str());
+}
+
+int main(int argc, char *argv[]) {
+    FILE *input = argc > 1 ? fopen(argv[1], "rb") : stdin;
+
+    if (input == nullptr) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    BinaryFrameDecoder decoder;
+    int byte;
+
+    while ((byte = fgetc(input)) != EOF) {
+        if (!decoder.push(static_cast<uint8_t>(byte))) {
+            continue;
+        }
+
+        const uint8_t *payload = decoder.getPayload();
+        const uint16_t length = decoder.getLength();
+
+        switch (decoder.getType()) {
+            case BinaryStatus:
+                printStatus(payload, length);
+                break;
+            case BinaryStation:
+                printStation("station", payload, length);
+                break;
+            case BinaryHeard:
+                printStation("heard", payload, length);
+                break;
+            case BinaryError:
+                printf("error,%u\n", length > 0 ? payload[0] : 0);
+                break;
+            case BinaryWatchdogFired:
+                printf("watchdog,%s\n", quote(reinterpret_cast<const char *>(payload), length).c_str());
+                break;
+            default:
+                fprintf(stderr, "Type %u unknown\n", decoder.getType());
+        }
+
+        fflush(stdout); // Each message as soon as received
+    }
+
+    if (decoder.errors > 0) {
+        fprintf(stderr, "%u frames not valid\n", decoder.errors);
+    }
+
+    return 0;
+}
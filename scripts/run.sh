@@ -8,6 +8,7 @@ MESHTASTIC_SERIAL_PORT="/dev/ttyS2"
 DATA_OUTPUT_DIR="/mnt/sdcard/data"
 REMOTE_DIR="valentin@192.168.1.254:/home/valentin/Data/cameras/opi"
 SLEEP_DURATION=150
+APRS_RECEIVED_MAX=256 # Comme APRS_HEARD_STATIONS du MCU, les stations gardées dans mcu.json
 
 # Fonction pour setup la carte
 startup() {
@@ -73,14 +74,28 @@ EOF
 }
 
 read_json_from_serial() {
+    # Seulement les sections utilisées et les stations APRS entendues depuis la dernière lecture,
+    # tout le JSON s'il n'y a pas encore de mcu.json complet
+    if [ -f "$DATA_OUTPUT_DIR/mcu.json" ] && [ -f "$DATA_OUTPUT_DIR/mcu.time" ]; then
+        COMMAND="jsonSince energy,box,weather,aprsReceived $(cat "$DATA_OUTPUT_DIR/mcu.time")"
+    else
+        COMMAND="json"
+    fi
+
     echo "Envoi de la commande sur le port série..."
-    echo -e "json" > "$SERIAL_PORT"
+    echo -e "$COMMAND" > "$SERIAL_PORT"
     JSON_RESPONSE=$(timeout 5s cat "$SERIAL_PORT")
 
     if [ -n "$JSON_RESPONSE" ] && echo "$JSON_RESPONSE" | jq -r '.' > /dev/null 2>&1; then
         echo "JSON reçu: $JSON_RESPONSE"
 
-        echo $"$JSON_RESPONSE" > "$DATA_OUTPUT_DIR/mcu.json"
+        if [ "$COMMAND" = "json" ]; then
+            echo $"$JSON_RESPONSE" > "$DATA_OUTPUT_DIR/mcu.json"
+        else
+            merge_json_delta
+        fi
+
+        echo "$JSON_RESPONSE" | jq '.time' > "$DATA_OUTPUT_DIR/mcu.time"
         return 0
     else
         echo "Erreur : Réponse non valide"
@@ -88,6 +103,21 @@ read_json_from_serial() {
     fi
 }
 
+# mcu.json reste complet pour la page web : les sections reçues remplacent les anciennes,
+# les stations reçues passent devant les anciennes sans doublon
+merge_json_delta() {
+    MERGED=$(echo "$JSON_RESPONSE" | jq --slurpfile full "$DATA_OUTPUT_DIR/mcu.json" --argjson max "$APRS_RECEIVED_MAX" '
+        . as $delta
+        | ($delta.aprsReceived // []) as $received
+        | ($received | map(.callsign)) as $callsigns
+        | ($full[0] * ($delta | del(.aprsReceived)))
+        | .aprsReceived = ($received + [($full[0].aprsReceived // [])[] | select(.callsign as $callsign | $callsigns | index($callsign) | not)])[:$max]')
+
+    if [ -n "$MERGED" ]; then
+        echo $"$MERGED" > "$DATA_OUTPUT_DIR/mcu.json"
+    fi
+}
+
 set_system_time() {
     TIMESTAMP_JSON=$(echo "$JSON_RESPONSE" | jq '.time')
     echo "Réglage de l'heure du système avec le timestamp : $TIMESTAMP_JSON"